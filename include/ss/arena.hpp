@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// arena string
+////////////////
+
+// value of a column stored within an arena, valid as long as the arena is
+// alive and not cleared
+struct arena_string {
+    std::string_view value;
+
+    operator std::string_view() const {
+        return value;
+    }
+};
+
+inline bool operator==(const arena_string& lhs, const arena_string& rhs) {
+    return lhs.value == rhs.value;
+}
+
+inline bool operator!=(const arena_string& lhs, const arena_string& rhs) {
+    return !(lhs == rhs);
+}
+
+////////////////
+// arena
+////////////////
+
+// bump allocator for column values, values are stored one after another
+// within large blocks which are only freed when the arena is destroyed,
+// clearing the arena invalidates all the values and reuses the memory
+class arena {
+public:
+    explicit arena(size_t block_size = 64 * 1024)
+        : block_size_{block_size == 0 ? 1 : block_size} {
+    }
+
+    // makes the arena safe to use from multiple threads at once
+    void synchronize() {
+        if (!mutex_) {
+            mutex_ = std::make_unique<std::mutex>();
+        }
+    }
+
+    std::string_view store(const char* const begin, const char* const end) {
+        size_t size = end - begin;
+        char* dst;
+        {
+            auto lock = lock_if_synchronized();
+            dst = allocate(size);
+        }
+        std::copy_n(begin, size, dst);
+        return {dst, size};
+    }
+
+    // number of bytes stored since the last clear
+    size_t size() const {
+        auto lock = lock_if_synchronized();
+        return size_;
+    }
+
+    void clear() {
+        auto lock = lock_if_synchronized();
+        // merge the blocks so that the next values are stored contiguously
+        if (blocks_.size() > 1) {
+            size_t capacity = 0;
+            for (const auto& b : blocks_) {
+                capacity += b.capacity;
+            }
+            blocks_.clear();
+            add_block(capacity);
+        }
+        used_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::unique_lock<std::mutex> lock_if_synchronized() const {
+        if (mutex_) {
+            return std::unique_lock{*mutex_};
+        }
+        return {};
+    }
+
+    struct block {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+    };
+
+    void add_block(size_t capacity) {
+        blocks_.push_back(
+            {std::unique_ptr<char[]>(new char[capacity]), capacity});
+    }
+
+    char* allocate(size_t size) {
+        if (blocks_.empty() || used_ + size > blocks_.back().capacity) {
+            add_block(std::max(block_size_, size));
+            used_ = 0;
+        }
+
+        char* ptr = blocks_.back().data.get() + used_;
+        used_ += size;
+        size_ += size;
+        return ptr;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    size_t block_size_;
+    std::vector<block> blocks_;
+    size_t used_{0};
+    size_t size_{0};
+    std::unique_ptr<std::mutex> mutex_;
+};
+
+} /* ss */
@@ -0,0 +1,384 @@
+#pragma once
+#include "parser.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////
+// arrow c data interface
+////////////////
+
+// structures as defined by the specification of the interface, they are
+// defined only if no other library defined them already
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+}
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace ss {
+
+////////////////
+// arrow column
+////////////////
+
+// values of one column stored in the arrow memory layout, a validity bitmap
+// and either fixed width values, bits for bools, or offsets and data for
+// strings
+template <typename T>
+class arrow_column {
+    constexpr static bool is_string = std::is_same_v<T, std::string>;
+    constexpr static bool is_bool = std::is_same_v<T, bool>;
+
+    static_assert(is_string || is_bool ||
+                      (std::is_arithmetic_v<T> && !std::is_same_v<T, char>),
+                  "arrow columns need to be of an integer, floating point, "
+                  "bool or std::string type");
+
+public:
+    arrow_column() {
+        if constexpr (is_string) {
+            offsets_.push_back(0);
+        }
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    size_t null_count() const {
+        return null_count_;
+    }
+
+    void append(std::optional<T>&& value) {
+        if (size_ % 8 == 0) {
+            validity_.push_back(0);
+            if constexpr (is_bool) {
+                values_.push_back(0);
+            }
+        }
+
+        if (value) {
+            validity_.back() |= bit(size_);
+            if constexpr (is_string) {
+                data_.append(*value);
+            } else if constexpr (is_bool) {
+                if (*value) {
+                    values_.back() |= bit(size_);
+                }
+            } else {
+                values_.push_back(*value);
+            }
+        } else {
+            ++null_count_;
+            if constexpr (!is_string && !is_bool) {
+                values_.push_back(T{});
+            }
+        }
+
+        if constexpr (is_string) {
+            offsets_.push_back(static_cast<int64_t>(data_.size()));
+        }
+        ++size_;
+    }
+
+    // moves the values into the given structures, they are owned by the
+    // structures and freed by their release callbacks
+    void export_to(ArrowArray* array, ArrowSchema* schema,
+                   const std::string& name) {
+        auto* h = new holder{std::move(*this), {}};
+        *this = arrow_column{};
+
+        h->buffers[0] = h->column.null_count_ ? h->column.validity_.data()
+                                              : nullptr;
+        const char* format_name = format();
+        if constexpr (is_string) {
+            // strings are exported with 32 bit offsets if they fit, and as
+            // large strings with 64 bit offsets otherwise
+            auto& c = h->column;
+            if (c.data_.size() <= std::numeric_limits<int32_t>::max()) {
+                c.small_offsets_.assign(c.offsets_.begin(), c.offsets_.end());
+                c.offsets_ = {};
+                h->buffers[1] = c.small_offsets_.data();
+            } else {
+                format_name = "U";
+                h->buffers[1] = c.offsets_.data();
+            }
+            h->buffers[2] = c.data_.data();
+        } else {
+            h->buffers[1] = h->column.values_.data();
+        }
+
+        *array = ArrowArray{static_cast<int64_t>(h->column.size_),
+                            static_cast<int64_t>(h->column.null_count_),
+                            0,
+                            is_string ? 3 : 2,
+                            0,
+                            h->buffers,
+                            nullptr,
+                            nullptr,
+                            &release_array,
+                            h};
+
+        // the children may be moved out of their parents by the consumer,
+        // so the schema owns its name
+        auto* schema_name = new std::string{name};
+        *schema = ArrowSchema{format_name,
+                              schema_name->c_str(),
+                              nullptr,
+                              ARROW_FLAG_NULLABLE,
+                              0,
+                              nullptr,
+                              nullptr,
+                              &release_schema,
+                              schema_name};
+    }
+
+private:
+    struct holder {
+        arrow_column column;
+        const void* buffers[3];
+    };
+
+    static uint8_t bit(size_t i) {
+        return static_cast<uint8_t>(1 << (i % 8));
+    }
+
+    constexpr static const char* format() {
+        if constexpr (is_string) {
+            return "u";
+        } else if constexpr (is_bool) {
+            return "b";
+        } else if constexpr (std::is_floating_point_v<T>) {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8,
+                          "unsupported floating point type");
+            return sizeof(T) == 4 ? "f" : "g";
+        } else {
+            constexpr bool s = std::is_signed_v<T>;
+            switch (sizeof(T)) {
+            case 1:
+                return s ? "c" : "C";
+            case 2:
+                return s ? "s" : "S";
+            case 4:
+                return s ? "i" : "I";
+            default:
+                return s ? "l" : "L";
+            }
+        }
+    }
+
+    static void release_array(ArrowArray* array) {
+        delete static_cast<holder*>(array->private_data);
+        array->release = nullptr;
+    }
+
+    static void release_schema(ArrowSchema* schema) {
+        delete static_cast<std::string*>(schema->private_data);
+        schema->release = nullptr;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    size_t size_{0};
+    size_t null_count_{0};
+    std::vector<uint8_t> validity_;
+    std::vector<ss::ternary_t<is_bool || is_string, uint8_t, T>> values_;
+    std::vector<int64_t> offsets_;
+    std::vector<int32_t> small_offsets_;
+    std::string data_;
+};
+
+////////////////
+// arrow builder
+////////////////
+
+// converts rows directly into arrow columns which can then be exported
+// through the arrow c data interface as a struct array without copying
+template <typename... Ts>
+class arrow_builder {
+    static_assert(sizeof...(Ts) > 0, "at least one column is needed");
+
+public:
+    arrow_builder() {
+        for (size_t i = 0; i < names_.size(); ++i) {
+            names_[i] = std::to_string(i);
+        }
+    }
+
+    explicit arrow_builder(std::vector<std::string> names) : arrow_builder{} {
+        for (size_t i = 0; i < names.size() && i < names_.size(); ++i) {
+            names_[i] = std::move(names[i]);
+        }
+    }
+
+    // number of rows
+    size_t size() const {
+        return std::get<0>(columns_).size();
+    }
+
+    // empty values are stored as nulls
+    void append(std::optional<Ts>... values) {
+        append_impl(std::index_sequence_for<Ts...>{}, std::move(values)...);
+    }
+
+    // reads all the remaining rows of the parser, columns which cannot be
+    // converted are stored as nulls, rows with an invalid number of columns
+    // are skipped, returns the number of skipped rows
+    template <typename... Matchers>
+    size_t read(parser<Matchers...>& p) {
+        size_t skipped = 0;
+        while (!p.eof()) {
+            auto values = p.template get_next<std::optional<Ts>...>();
+            if (!p.valid()) {
+                ++skipped;
+                continue;
+            }
+
+            if constexpr (sizeof...(Ts) == 1) {
+                append(std::move(values));
+            } else {
+                std::apply([this](auto&&... v) { append(std::move(v)...); },
+                           std::move(values));
+            }
+        }
+        return skipped;
+    }
+
+    // exports the columns as a struct array, the builder is empty
+    // afterwards, both structures need to be released by the consumer
+    void export_to(ArrowArray* array, ArrowSchema* schema) {
+        constexpr size_t n = sizeof...(Ts);
+        auto* h = new holder{};
+        export_columns(h, std::index_sequence_for<Ts...>{});
+        for (size_t i = 0; i < n; ++i) {
+            h->array_children[i] = &h->arrays[i];
+            h->schema_children[i] = &h->schemas[i];
+        }
+
+        *array = ArrowArray{h->arrays[0].length,
+                            0,
+                            0,
+                            1,
+                            static_cast<int64_t>(n),
+                            h->buffers,
+                            h->array_children,
+                            nullptr,
+                            &release_array,
+                            h};
+
+        *schema = ArrowSchema{"+s",
+                              "",
+                              nullptr,
+                              0,
+                              static_cast<int64_t>(n),
+                              h->schema_children,
+                              nullptr,
+                              &release_schema,
+                              h};
+    }
+
+private:
+    struct holder {
+        ArrowArray arrays[sizeof...(Ts)];
+        ArrowSchema schemas[sizeof...(Ts)];
+        ArrowArray* array_children[sizeof...(Ts)];
+        ArrowSchema* schema_children[sizeof...(Ts)];
+        const void* buffers[1]{nullptr};
+        bool schema_released{false};
+        bool array_released{false};
+    };
+
+    template <size_t... Is>
+    void append_impl(std::index_sequence<Is...>,
+                     std::optional<Ts>&&... values) {
+        (std::get<Is>(columns_).append(std::move(values)), ...);
+    }
+
+    template <size_t... Is>
+    void export_columns(holder* h, std::index_sequence<Is...>) {
+        (std::get<Is>(columns_).export_to(&h->arrays[Is], &h->schemas[Is],
+                                          names_[Is]),
+         ...);
+    }
+
+    // the children of the array and the schema are stored together, so
+    // they are freed once both are released
+    static void release(holder* h) {
+        if (h->schema_released && h->array_released) {
+            delete h;
+        }
+    }
+
+    static void release_array(ArrowArray* array) {
+        auto* h = static_cast<holder*>(array->private_data);
+        for (auto& child : h->arrays) {
+            if (child.release) {
+                child.release(&child);
+            }
+        }
+        array->release = nullptr;
+        h->array_released = true;
+        release(h);
+    }
+
+    static void release_schema(ArrowSchema* schema) {
+        auto* h = static_cast<holder*>(schema->private_data);
+        for (auto& child : h->schemas) {
+            if (child.release) {
+                child.release(&child);
+            }
+        }
+        schema->release = nullptr;
+        h->schema_released = true;
+        release(h);
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::array<std::string, sizeof...(Ts)> names_;
+    std::tuple<arrow_column<Ts>...> columns_;
+};
+
+} /* ss */
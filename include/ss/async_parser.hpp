@@ -0,0 +1,266 @@
+#pragma once
+
+#include "common.hpp"
+#include "converter.hpp"
+#include "generator.hpp"
+#include <cstdlib>
+#include <iterator>
+#include <string>
+
+#ifdef __cpp_impl_coroutine
+
+namespace ss {
+
+////////////////
+// async parser
+////////////////
+
+// parses data received in chunks from an asynchronous source, the source is
+// co_awaited only once the buffered data contains no more complete records,
+// so rows can be parsed on the same thread on which the source is read
+template <typename... Matchers>
+class async_parser {
+    constexpr static auto string_error = setup<Matchers...>::string_error;
+
+    using multiline = typename setup<Matchers...>::multiline;
+    using comment = typename setup<Matchers...>::comment;
+    constexpr static bool ignore_empty = setup<Matchers...>::ignore_empty;
+
+    static_assert(!setup<Matchers...>::quarantine,
+                  "quarantine is not supported by the async parser");
+    static_assert(!setup<Matchers...>::follow,
+                  "follow is not supported by the async parser");
+
+    using error_type = ss::ternary_t<string_error, std::string, bool>;
+
+public:
+    // the name is only used within error messages
+    async_parser(const std::string& name = "",
+                 const std::string& delim = ss::default_delimiter)
+        : name_{name}, delim_{delim} {}
+
+    async_parser(const async_parser& other) = delete;
+    async_parser& operator=(const async_parser& other) = delete;
+
+    bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else {
+            return !error_;
+        }
+    }
+
+    const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    bool eof() const { return eof_; }
+
+    // generator of the rows of the data, the source is invoked to get the
+    // next chunk of the data and its result is co_awaited, the result needs
+    // to be a std::string or a std::string_view, an empty chunk marks the
+    // end of the data, the validity of each row can be checked using the
+    // valid method, the parser needs to outlive the generator
+    template <typename... Ts, typename Source>
+    async_generator<no_void_validator_tup_t<Ts...>> rows(Source source) {
+        buffer_.clear();
+        begin_ = 0;
+        line_number_ = 0;
+        eof_ = false;
+
+        bool last = false;
+        while (true) {
+            if (!read_record(last)) {
+                if (last) {
+                    break;
+                }
+
+                auto&& chunk = co_await source();
+                buffer_.erase(0, begin_);
+                begin_ = 0;
+                if (std::empty(chunk)) {
+                    last = true;
+                } else {
+                    buffer_.append(chunk);
+                }
+                continue;
+            }
+
+            clear_error();
+            if (limit_reached_) {
+                set_error_invalid_record("multiline limit reached.");
+                co_yield no_void_validator_tup_t<Ts...>{};
+                continue;
+            }
+
+            auto value =
+                converter_.template convert<Ts...>(record_.data(), delim_);
+            if (!converter_.valid()) {
+                if constexpr (string_error) {
+                    set_error_invalid_record(converter_.error_msg());
+                } else {
+                    set_error_invalid_record({});
+                }
+            }
+            co_yield value;
+        }
+
+        eof_ = true;
+    }
+
+private:
+    ////////////////
+    // error
+    ////////////////
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    void set_error_invalid_record(const std::string& msg) {
+        if constexpr (string_error) {
+            error_.append(name_)
+                .append(" ")
+                .append(std::to_string(line_number_))
+                .append(": ")
+                .append(msg)
+                .append(": \"")
+                .append(record_.c_str())
+                .append("\"");
+        } else {
+            (void)msg;
+            error_ = true;
+        }
+    }
+
+    ////////////////
+    // reading
+    ////////////////
+
+    // finds the line beginning at 'begin', returns false if the line is
+    // not complete yet, or if there is no line left
+    bool read_line(size_t begin, size_t& end, bool last) const {
+        if (begin == buffer_.size()) {
+            return false;
+        }
+
+        size_t eol = buffer_.find('\n', begin);
+        if (eol == std::string::npos) {
+            if (!last) {
+                return false;
+            }
+            end = buffer_.size();
+        } else {
+            end = eol + 1;
+        }
+        return true;
+    }
+
+    // end of the line without the new line characters
+    size_t content_end(size_t begin, size_t end) const {
+        if (end > begin && buffer_[end - 1] == '\n') {
+            --end;
+            if (end > begin && buffer_[end - 1] == '\r') {
+                --end;
+            }
+        }
+        return end;
+    }
+
+    // empty and comment lines, if enabled
+    bool ignored(size_t begin, size_t end) const {
+        size_t size = content_end(begin, end) - begin;
+        if constexpr (ignore_empty) {
+            if (size == 0) {
+                return true;
+            }
+        }
+        if constexpr (comment::enabled) {
+            if (size != 0 && comment::match(buffer_[begin])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // copies the next complete record of the buffer, nothing is consumed if
+    // the record is not complete yet, so it is read again once more data is
+    // received
+    bool read_record(bool last) {
+        size_t begin = begin_;
+        size_t end = begin_;
+        size_t lines = 0;
+        while (true) {
+            if (!read_line(begin, end, last)) {
+                return false;
+            }
+            ++lines;
+            if (!ignored(begin, end)) {
+                break;
+            }
+            begin = end;
+        }
+
+        size_t record_begin = begin;
+        bool limit_reached = false;
+        if constexpr (multiline::enabled) {
+            scanner_.reset();
+            size_t limit = 0;
+            while (!scanner_.scan(buffer_.data() + begin,
+                                  buffer_.data() + content_end(begin, end))) {
+                if constexpr (multiline::size > 0) {
+                    if (limit++ >= multiline::size) {
+                        limit_reached = true;
+                        break;
+                    }
+                }
+
+                // the new line stays within the record
+                begin = end;
+                if (!read_line(begin, end, last)) {
+                    if (!last) {
+                        return false;
+                    }
+                    // unterminated record, the converter reports the error
+                    break;
+                }
+                ++lines;
+            }
+        }
+
+        record_.assign(buffer_, record_begin,
+                       content_end(record_begin, end) - record_begin);
+        begin_ = end;
+        line_number_ += lines;
+        limit_reached_ = limit_reached;
+        return true;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string name_;
+    std::string delim_;
+    error_type error_{};
+    bool eof_{false};
+
+    converter<Matchers...> converter_;
+    record_scanner<Matchers...> scanner_{delim_};
+
+    // received data which is not consumed yet starts at 'begin_'
+    std::string buffer_;
+    size_t begin_{0};
+    std::string record_;
+    size_t line_number_{0};
+    bool limit_reached_{false};
+};
+
+} /* ss */
+
+#endif
@@ -0,0 +1,422 @@
+#pragma once
+#include "common.hpp"
+#include "parser.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// cached parser
+////////////////
+
+// parses a file once and stores the converted rows into a binary cache file,
+// later the rows are read from the cache as long as the size and the
+// modification time of the file, the delimiter, the setup and the types of
+// the columns match, columns need to be trivially copyable or std::string,
+// and cannot hold pointers or views (eg. std::string_view), the cache is only
+// meant to be read by the same build which wrote it
+template <typename... Matchers>
+class cached_parser {
+    constexpr static auto string_error = setup<Matchers...>::string_error;
+
+    using error_type = ss::ternary_t<string_error, std::string, bool>;
+
+    constexpr static char magic[4] = {'s', 's', 'c', 'p'};
+    constexpr static uint32_t version = 1;
+
+public:
+    cached_parser(const std::string& file_name,
+                  const std::string& delim = ss::default_delimiter,
+                  const std::string& cache_file_name = "")
+        : file_name_{file_name}, delim_{delim},
+          cache_file_name_{cache_file_name.empty() ? file_name + ".sscache"
+                                                   : cache_file_name} {
+    }
+
+    bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else {
+            return !error_;
+        }
+    }
+
+    const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    // true if the rows of the last for_each were read from the cache
+    bool cached() const {
+        return cached_;
+    }
+
+    const std::string& cache_file_name() const {
+        return cache_file_name_;
+    }
+
+    // invokes the function with each valid row of the file, the function
+    // may accept no arguments, the whole tuple, or the elements of the
+    // tuple, the cache is written only if all the rows are valid
+    template <typename... Ts, typename Fun>
+    void for_each(Fun&& fun) {
+        using value = no_void_validator_tup_t<Ts...>;
+        static_assert(is_cacheable<value>::value,
+                      "cached columns need to be trivially copyable or "
+                      "std::string, and cannot hold pointers or views");
+
+        clear_error();
+        cached_ = false;
+
+        std::string key = make_key<Ts...>();
+        if (read_cache<value>(key, fun)) {
+            cached_ = true;
+            return;
+        }
+
+        parser<Matchers...> p{file_name_, delim_};
+        std::string rows;
+        size_t count = 0;
+        while (!p.eof()) {
+            auto v = p.template get_next<Ts...>();
+            if (!p.valid()) {
+                if (valid()) {
+                    set_error(p);
+                }
+                continue;
+            }
+
+            encode(rows, v);
+            ++count;
+            invoke(std::move(v), fun);
+        }
+
+        if (valid()) {
+            write_cache(key, rows, count);
+        }
+    }
+
+private:
+    struct header {
+        char magic[4];
+        uint32_t version;
+        uint64_t key_size;
+        uint64_t rows_size;
+        uint64_t rows;
+    };
+
+    ////////////////
+    // error
+    ////////////////
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    void set_error(const parser<Matchers...>& p) {
+        if constexpr (string_error) {
+            error_ = p.error_msg();
+        } else {
+            (void)p;
+            error_ = true;
+        }
+    }
+
+    ////////////////
+    // key
+    ////////////////
+
+    // identifies the file, the way it is parsed and the types of the rows
+    template <typename... Ts>
+    std::string make_key() const {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(file_name_, ec);
+        if (ec) {
+            return {};
+        }
+        auto time = std::filesystem::last_write_time(file_name_, ec);
+        if (ec) {
+            return {};
+        }
+
+        std::string key;
+        key.append(std::to_string(size))
+            .append(":")
+            .append(std::to_string(time.time_since_epoch().count()))
+            .append(":")
+            .append(delim_)
+            .append(":")
+            .append(typeid(setup<Matchers...>).name());
+        ((key.append(":").append(typeid(Ts).name())), ...);
+        return key;
+    }
+
+    ////////////////
+    // encoding
+    ////////////////
+
+    // values holding pointers (eg. std::string_view, ss::dict_string) are
+    // not cacheable since they would point to memory of a previous run
+    template <typename T>
+    struct is_cacheable
+        : std::disjunction<
+              std::is_same<T, std::string>,
+              std::conjunction<
+                  std::is_trivially_copyable<T>,
+                  std::negation<std::is_pointer<T>>,
+                  std::negation<std::is_member_pointer<T>>,
+                  std::negation<std::is_same<T, std::string_view>>,
+                  std::negation<std::is_same<T, dict_string>>,
+                  std::negation<std::is_same<T, arena_string>>>> {};
+
+    template <typename... Ts>
+    struct is_cacheable<std::tuple<Ts...>>
+        : std::conjunction<is_cacheable<Ts>...> {};
+
+    template <typename T, typename U>
+    struct is_cacheable<std::pair<T, U>>
+        : std::conjunction<std::is_trivially_copyable<std::pair<T, U>>,
+                           is_cacheable<T>, is_cacheable<U>> {};
+
+    template <typename T>
+    struct is_cacheable<std::optional<T>>
+        : std::conjunction<std::is_trivially_copyable<std::optional<T>>,
+                           is_cacheable<T>> {};
+
+    template <typename... Ts>
+    struct is_cacheable<std::variant<Ts...>>
+        : std::conjunction<std::is_trivially_copyable<std::variant<Ts...>>,
+                           is_cacheable<Ts>...> {};
+
+    template <typename T, size_t N>
+    struct is_cacheable<std::array<T, N>> : is_cacheable<T> {};
+
+    template <typename T>
+    static void encode_element(std::string& out, const T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            uint64_t size = value.size();
+            out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+            out.append(value);
+        } else {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    template <typename T>
+    static void encode(std::string& out, const T& value) {
+        if constexpr (is_instance_of_v<std::tuple, T>) {
+            std::apply(
+                [&](const auto&... elements) {
+                    (encode_element(out, elements), ...);
+                },
+                value);
+        } else {
+            encode_element(out, value);
+        }
+    }
+
+    template <typename T>
+    static void decode_element(const char*& in, T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            uint64_t size;
+            std::memcpy(&size, in, sizeof(size));
+            in += sizeof(size);
+            value.assign(in, size);
+            in += size;
+        } else {
+            std::memcpy(&value, in, sizeof(value));
+            in += sizeof(value);
+        }
+    }
+
+    template <typename T>
+    static void decode(const char*& in, T& value) {
+        if constexpr (is_instance_of_v<std::tuple, T>) {
+            std::apply(
+                [&](auto&... elements) { (decode_element(in, elements), ...); },
+                value);
+        } else {
+            decode_element(in, value);
+        }
+    }
+
+    // moves over an encoded element, false if it does not fit into the rows
+    template <typename T>
+    static bool skip_element(const char*& in, const char* end) {
+        size_t size = sizeof(T);
+        if constexpr (std::is_same_v<T, std::string>) {
+            uint64_t string_size;
+            if (static_cast<size_t>(end - in) < sizeof(string_size)) {
+                return false;
+            }
+            std::memcpy(&string_size, in, sizeof(string_size));
+            in += sizeof(string_size);
+            size = string_size;
+        }
+
+        if (static_cast<size_t>(end - in) < size) {
+            return false;
+        }
+        in += size;
+        return true;
+    }
+
+    template <typename T>
+    struct skip_all;
+
+    template <typename... Ts>
+    struct skip_all<std::tuple<Ts...>> {
+        static bool skip(const char*& in, const char* end) {
+            return (skip_element<Ts>(in, end) && ...);
+        }
+    };
+
+    // checks that the rows of a cache file can be decoded, so that a
+    // truncated or corrupt cache is never read out of bounds
+    template <typename T>
+    static bool check_rows(const std::string& rows, uint64_t count) {
+        const char* in = rows.data();
+        const char* end = rows.data() + rows.size();
+        for (uint64_t i = 0; i < count; ++i) {
+            bool ok;
+            if constexpr (is_instance_of_v<std::tuple, T>) {
+                ok = skip_all<T>::skip(in, end);
+            } else {
+                ok = skip_element<T>(in, end);
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        return in == end;
+    }
+
+    ////////////////
+    // cache
+    ////////////////
+
+    template <typename Value, typename Fun>
+    bool read_cache(const std::string& key, Fun& fun) {
+        if (key.empty()) {
+            return false;
+        }
+
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(cache_file_name_, ec);
+        if (ec) {
+            return false;
+        }
+
+        FILE* file = fopen(cache_file_name_.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+
+        header h;
+        std::string stored_key;
+        std::string rows;
+        bool ok = fread(&h, sizeof(h), 1, file) == 1 &&
+                  std::memcmp(h.magic, magic, sizeof(magic)) == 0 &&
+                  h.version == version && h.key_size == key.size() &&
+                  file_size >= sizeof(h) + h.key_size &&
+                  h.rows_size == file_size - sizeof(h) - h.key_size;
+        if (ok) {
+            stored_key.resize(h.key_size);
+            ok = fread(stored_key.data(), 1, stored_key.size(), file) ==
+                     stored_key.size() &&
+                 stored_key == key;
+        }
+        if (ok) {
+            // the rows are read at once
+            rows.resize(h.rows_size);
+            ok = fread(rows.data(), 1, rows.size(), file) == rows.size();
+        }
+        fclose(file);
+        if (!ok || !check_rows<Value>(rows, h.rows)) {
+            return false;
+        }
+
+        const char* in = rows.data();
+        Value value;
+        for (size_t i = 0; i < h.rows; ++i) {
+            decode(in, value);
+            invoke(std::move(value), fun);
+        }
+        return true;
+    }
+
+    void write_cache(const std::string& key, const std::string& rows,
+                     size_t count) {
+        if (key.empty()) {
+            return;
+        }
+
+        // written into a temporary file first so that a cache which is
+        // being written is never read
+        std::string tmp_file_name = cache_file_name_ + ".tmp";
+        FILE* file = fopen(tmp_file_name.c_str(), "wb");
+        if (!file) {
+            return;
+        }
+
+        header h{{}, version, key.size(), rows.size(), count};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        bool ok = fwrite(&h, sizeof(h), 1, file) == 1 &&
+                  fwrite(key.data(), 1, key.size(), file) == key.size() &&
+                  fwrite(rows.data(), 1, rows.size(), file) == rows.size();
+        ok = (fclose(file) == 0) && ok;
+
+        std::error_code ec;
+        if (ok) {
+            std::filesystem::rename(tmp_file_name, cache_file_name_, ec);
+        }
+        if (!ok || ec) {
+            std::filesystem::remove(tmp_file_name, ec);
+        }
+    }
+
+    ////////////////
+    // invoking
+    ////////////////
+
+    template <typename Arg, typename Fun>
+    static void invoke(Arg&& arg, Fun& fun) {
+        if constexpr (std::is_invocable_v<Fun>) {
+            fun();
+        } else if constexpr (std::is_invocable_v<Fun, Arg>) {
+            std::invoke(fun, std::forward<Arg>(arg));
+        } else {
+            std::apply(fun, std::forward<Arg>(arg));
+        }
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string file_name_;
+    std::string delim_;
+    std::string cache_file_name_;
+    error_type error_{};
+    bool cached_{false};
+};
+
+} /* ss */
@@ -13,6 +13,34 @@ using split_data = std::vector<string_range>;
 
 constexpr inline auto default_delimiter = ",";
 
+// position of a row within a file, the number of lines before the row is
+// kept so that line numbers stay correct after seeking
+struct position {
+    size_t offset{0};
+    size_t line_number{0};
+};
+
+// rows of a file starting at the given position
+struct row_range {
+    ss::position begin;
+    size_t rows{0};
+};
+
+// kind of the error of an invalid row
+enum class error_code : uint8_t {
+    none,
+    // unterminated quote or escape, or mismatched quote
+    invalid_split,
+    multiline_limit_reached,
+    number_of_columns,
+    invalid_conversion,
+    validation,
+    invalid_utf8
+};
+
+// column of the errors which are not related to a single column
+constexpr inline size_t no_column = static_cast<size_t>(-1);
+
 template <bool StringError>
 inline void assert_string_error_defined() {
     static_assert(StringError,
@@ -1,11 +1,21 @@
 #pragma once
+#include "arena.hpp"
+#include "dictionary.hpp"
+#include "enum_map.hpp"
 #include "extract.hpp"
 #include "function_traits.hpp"
 #include "restrictions.hpp"
 #include "splitter.hpp"
 #include "type_traits.hpp"
+#include "utf8.hpp"
+#include <algorithm>
+#include <any>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 namespace ss {
@@ -31,6 +41,11 @@ struct no_validator<T, typename std::enable_if_t<has_m_ss_valid_t<T>>> {
     using type = typename member_wrapper<decltype(&T::ss_valid)>::arg_type;
 };
 
+template <typename T>
+struct no_validator<T, typename std::enable_if_t<is_enum_map_v<T>>> {
+    using type = typename T::enum_type;
+};
+
 template <typename T, typename U>
 struct no_validator {
     using type = T;
@@ -100,6 +115,7 @@ class converter {
     using line_ptr_type = typename splitter<Matchers...>::line_ptr_type;
 
     constexpr static auto string_error = setup<Matchers...>::string_error;
+    constexpr static auto utf8 = setup<Matchers...>::utf8;
     constexpr static auto default_delimiter = ",";
 
     using error_type = ss::ternary_t<string_error, std::string, bool>;
@@ -114,10 +130,17 @@ public:
     }
 
     // parses line with given delimiter, returns tuple of objects with
-    // extracted values of type 'Ts'
+    // extracted values of type 'Ts', if utf8 is enabled lines which are not
+    // valid utf-8 are not converted
     template <typename... Ts>
     no_void_validator_tup_t<Ts...> convert(
         line_ptr_type line, const std::string& delim = default_delimiter) {
+        if constexpr (utf8) {
+            if (!check_utf8(line)) {
+                no_void_validator_tup_t<Ts...> ret{};
+                return ret;
+            }
+        }
         split(line, delim);
         return convert<Ts...>(splitter_.split_data_);
     }
@@ -159,6 +182,54 @@ public:
         return convert<T, Ts...>(splitter_.split_data_);
     }
 
+    // converts the lines within [first, last) and writes the value of every
+    // line to 'out', the lines can be null terminated strings, std::strings
+    // or std::string_views, the split data and the buffer into which the
+    // lines are copied if needed are reused, so no memory is allocated per
+    // line once they are large enough, the values of the lines which could
+    // not be converted are not valid, the function is invoked with the
+    // index of each such line while its error is still set, returns the
+    // number of such lines, disjoint ranges of lines can be converted
+    // concurrently using one converter per thread
+    template <typename... Ts, typename InputIt, typename OutputIt,
+              typename Fun = none>
+    size_t convert_many(InputIt first, InputIt last, OutputIt out,
+                        const std::string& delim = default_delimiter,
+                        Fun&& on_error = {}) {
+        size_t invalid = 0;
+        for (size_t i = 0; first != last; ++first, ++out, ++i) {
+            *out = convert<Ts...>(line_of(*first), delim);
+            if (!valid()) {
+                ++invalid;
+                if constexpr (!std::is_same_v<std::decay_t<Fun>, none>) {
+                    on_error(i);
+                }
+            }
+        }
+        return invalid;
+    }
+
+    // converts only one column of the cached split line
+    template <typename T>
+    no_validator_t<T> convert_column(size_t column) {
+        clear_error();
+        no_validator_t<T> value{};
+
+        if (!splitter_.valid()) {
+            set_error_unterminated_quote();
+            return value;
+        }
+
+        if (column >= splitter_.split_data_.size()) {
+            set_error_number_of_colums(column + 1,
+                                       splitter_.split_data_.size());
+            return value;
+        }
+
+        extract_one<T>(value, splitter_.split_data_[column], column);
+        return value;
+    }
+
     bool valid() const {
         if constexpr (string_error) {
             return error_.empty();
@@ -176,10 +247,27 @@ public:
         return splitter_.unterminated_quote();
     }
 
+    // dictionary in which the values of 'dict_string' columns are stored
+    ss::dictionary& dictionary() {
+        if (!dictionary_) {
+            dictionary_ = std::make_shared<ss::dictionary>();
+        }
+        return *dictionary_;
+    }
+
+    // arena in which the values of 'arena_string' columns are stored
+    ss::arena& arena() {
+        if (!arena_) {
+            arena_ = std::make_shared<ss::arena>();
+        }
+        return *arena_;
+    }
+
     // 'splits' string by given delimiter, returns vector of pairs which
     // contain the beginnings and the ends of each column of the string
     const split_data& split(line_ptr_type line,
                             const std::string& delim = default_delimiter) {
+        memo_.clear();
         splitter_.split_data_.clear();
         if (line[0] == '\0') {
             return splitter_.split_data_;
@@ -202,6 +290,54 @@ private:
         return splitter_.size_shifted();
     }
 
+    // lines which may not be null terminated, or which would be modified
+    // by the splitter while being const, are copied into a reused buffer
+    template <typename Line>
+    line_ptr_type line_of(const Line& line) {
+        if constexpr (std::is_convertible_v<const Line&, line_ptr_type>) {
+            return line;
+        } else if constexpr (std::is_same_v<Line, std::string> &&
+                             std::is_same_v<line_ptr_type, const char*>) {
+            return line.c_str();
+        } else {
+            std::string_view view{line};
+            line_buffer_.assign(view.data(), view.size());
+            return line_buffer_.data();
+        }
+    }
+
+    ////////////////
+    // memo
+    ////////////////
+
+    // if enabled, the conversions of the columns of the split line are
+    // remembered by their column and type until the next line is split, so
+    // that converting the same line multiple times, with different types,
+    // converts the columns the conversions have in common only once
+    void memoize(bool enabled) {
+        memoize_ = enabled;
+    }
+
+    ////////////////
+    // storage
+    ////////////////
+
+    template <typename T>
+    static void share(std::shared_ptr<T>& lhs, std::shared_ptr<T>& rhs) {
+        if (!lhs) {
+            lhs = rhs;
+        } else if (!rhs) {
+            rhs = lhs;
+        }
+    }
+
+    // makes both converters use the same dictionary and arena if one of
+    // them has it
+    void share_storage(converter& other) {
+        share(dictionary_, other.dictionary_);
+        share(arena_, other.arena_);
+    }
+
     ////////////////
     // error
     ////////////////
@@ -212,6 +348,12 @@ private:
         } else {
             error_ = false;
         }
+        error_code_ = error_code::none;
+    }
+
+    void set_error_code(error_code code, size_t column = no_column) {
+        error_code_ = code;
+        error_column_ = column;
     }
 
     std::string error_sufix(const string_range msg, size_t pos) const {
@@ -226,6 +368,7 @@ private:
     }
 
     void set_error_unterminated_quote() {
+        set_error_code(error_code::invalid_split);
         if constexpr (string_error) {
             error_.clear();
             error_.append(splitter_.error_msg());
@@ -235,6 +378,7 @@ private:
     }
 
     void set_error_unterminated_escape() {
+        set_error_code(error_code::invalid_split);
         if constexpr (string_error) {
             error_.clear();
             splitter_.set_error_unterminated_escape();
@@ -246,6 +390,7 @@ private:
 
 
     void set_error_multiline_limit_reached() {
+        set_error_code(error_code::multiline_limit_reached);
         if constexpr (string_error) {
             error_.clear();
             error_.append("multiline limit reached.");
@@ -255,6 +400,7 @@ private:
     }
 
     void set_error_invalid_conversion(const string_range msg, size_t pos) {
+        set_error_code(error_code::invalid_conversion, pos);
         if constexpr (string_error) {
             error_.clear();
             error_.append("invalid conversion for parameter ")
@@ -266,6 +412,7 @@ private:
 
     void set_error_validate(const char* const error, const string_range msg,
                             size_t pos) {
+        set_error_code(error_code::validation, pos);
         if constexpr (string_error) {
             error_.clear();
             error_.append(error).append(" ").append(error_sufix(msg, pos));
@@ -274,7 +421,40 @@ private:
         }
     }
 
+    template <typename T>
+    void set_error_validate(const string_range msg, size_t pos) {
+        if constexpr (has_m_error_t<T>) {
+            set_error_validate(T{}.error(), msg, pos);
+        } else {
+            set_error_validate("validation error", msg, pos);
+        }
+    }
+
+    bool check_utf8(const char* line) {
+        size_t size = std::strlen(line);
+        size_t position = find_invalid_utf8(line, size);
+        if (position != size) {
+            set_error_invalid_utf8(position);
+            return false;
+        }
+        return true;
+    }
+
+    void set_error_invalid_utf8(size_t position) {
+        set_error_code(error_code::invalid_utf8);
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append("invalid utf-8 at position: ")
+                .append(std::to_string(position));
+        } else {
+            error_ = true;
+        }
+    }
+
     void set_error_number_of_colums(size_t expected_pos, size_t pos) {
+        // the first missing or extra column
+        set_error_code(error_code::number_of_columns,
+                       std::min(expected_pos, pos));
         if constexpr (string_error) {
             error_.clear();
             error_.append("invalid number of columns, expected: ")
@@ -327,23 +507,79 @@ private:
             return;
         }
 
+        using value_type = no_validator_t<T>;
+        if constexpr (std::is_copy_constructible_v<value_type> &&
+                      std::is_copy_assignable_v<value_type>) {
+            if (memoize_) {
+                extract_memoized<T>(dst, msg, pos);
+                return;
+            }
+        }
+        extract_value<T>(dst, msg, pos);
+    }
+
+    template <typename T>
+    void extract_memoized(no_validator_t<T>& dst, const string_range msg,
+                          size_t pos) {
+        for (const auto& e : memo_) {
+            if (e.column == pos && *e.type == typeid(T)) {
+                if (e.code == error_code::none) {
+                    dst = std::any_cast<const no_validator_t<T>&>(e.value);
+                } else {
+                    // failed conversions are memoized too
+                    error_ = e.error;
+                    set_error_code(e.code, pos);
+                }
+                return;
+            }
+        }
+
+        extract_value<T>(dst, msg, pos);
+        if (valid()) {
+            memo_.push_back({pos, &typeid(T), dst, {}, error_code::none});
+        } else {
+            memo_.push_back({pos, &typeid(T), {}, error_, error_code_});
+        }
+    }
+
+    template <typename T>
+    void extract_value(no_validator_t<T>& dst, const string_range msg,
+                       size_t pos) {
         if constexpr (std::is_same_v<T, std::string>) {
             extract(msg.first, msg.second, dst);
             return;
         }
 
-        if (!extract(msg.first, msg.second, dst)) {
+        if constexpr (bounds<T>::enabled) {
+            // the bounds are checked while the value is converted
+            auto result =
+                to_num_bounded<no_validator_t<T>, bounds<T>::min,
+                               bounds<T>::max>(msg.first, msg.second, dst);
+            if (result == bounded_result::invalid) {
+                set_error_invalid_conversion(msg, pos);
+            } else if (result == bounded_result::out_of_range) {
+                set_error_validate<T>(msg, pos);
+            }
+            return;
+        }
+
+        if constexpr (is_enum_map_v<T>) {
+            if (!T::decode(msg.first, msg.second, dst)) {
+                set_error_invalid_conversion(msg, pos);
+                return;
+            }
+        } else if constexpr (std::is_same_v<no_validator_t<T>, dict_string>) {
+            dst = dictionary().intern(msg.first, msg.second);
+        } else if constexpr (std::is_same_v<no_validator_t<T>, arena_string>) {
+            dst.value = arena().store(msg.first, msg.second);
+        } else if (!extract(msg.first, msg.second, dst)) {
             set_error_invalid_conversion(msg, pos);
             return;
         }
 
         if constexpr (has_m_ss_valid_t<T>) {
             if (T validator; !validator.ss_valid(dst)) {
-                if constexpr (has_m_error_t<T>) {
-                    set_error_validate(validator.error(), msg, pos);
-                } else {
-                    set_error_validate("validation error", msg, pos);
-                }
+                set_error_validate<T>(msg, pos);
                 return;
             }
         }
@@ -386,10 +622,32 @@ private:
     ////////////////
 
     error_type error_{};
+    error_code error_code_{error_code::none};
+    size_t error_column_{no_column};
     splitter<Matchers...> splitter_;
+    std::shared_ptr<ss::dictionary> dictionary_;
+    std::shared_ptr<ss::arena> arena_;
+    std::string line_buffer_;
+
+    struct memo_entry {
+        size_t column;
+        const std::type_info* type;
+        std::any value;
+        error_type error;
+        error_code code;
+    };
+
+    bool memoize_{false};
+    std::vector<memo_entry> memo_;
 
     template <typename...>
     friend class parser;
+
+    template <typename...>
+    friend class row_view;
+
+    template <typename...>
+    friend class pipeline;
 };
 
 } /* ss */
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ss {
+
+////////////////
+// dict string
+////////////////
+
+// value of a column stored within a dictionary, the same values share the
+// same id and the same memory, valid as long as the dictionary is alive and
+// not cleared
+struct dict_string {
+    size_t id{0};
+    std::string_view value;
+
+    operator std::string_view() const {
+        return value;
+    }
+};
+
+inline bool operator==(const dict_string& lhs, const dict_string& rhs) {
+    return lhs.value == rhs.value;
+}
+
+inline bool operator!=(const dict_string& lhs, const dict_string& rhs) {
+    return !(lhs == rhs);
+}
+
+////////////////
+// dictionary
+////////////////
+
+// interns column values, every distinct value is stored only once and gets
+// an id in the order in which it was first seen
+class dictionary {
+public:
+    // makes the dictionary safe to use from multiple threads at once
+    void synchronize() {
+        if (!mutex_) {
+            mutex_ = std::make_unique<std::mutex>();
+        }
+    }
+
+    dict_string intern(const char* const begin, const char* const end) {
+        auto lock = lock_if_synchronized();
+        std::string_view value{begin, static_cast<size_t>(end - begin)};
+        if (auto it = ids_.find(value); it != ids_.end()) {
+            return {it->second, values_[it->second]};
+        }
+
+        size_t id = values_.size();
+        // elements of a deque are never moved, views to them stay valid
+        std::string_view stored = values_.emplace_back(value);
+        ids_.emplace(stored, id);
+        return {id, stored};
+    }
+
+    std::string_view operator[](size_t id) const {
+        auto lock = lock_if_synchronized();
+        return values_[id];
+    }
+
+    size_t size() const {
+        auto lock = lock_if_synchronized();
+        return values_.size();
+    }
+
+    void clear() {
+        auto lock = lock_if_synchronized();
+        ids_.clear();
+        values_.clear();
+    }
+
+private:
+    std::unique_lock<std::mutex> lock_if_synchronized() const {
+        if (mutex_) {
+            return std::unique_lock{*mutex_};
+        }
+        return {};
+    }
+
+    std::deque<std::string> values_;
+    std::unordered_map<std::string_view, size_t> ids_;
+    std::unique_ptr<std::mutex> mutex_;
+};
+
+} /* ss */
@@ -0,0 +1,235 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+namespace ss {
+
+////////////////
+// token
+////////////////
+
+// text of a column and the enum value it stands for
+template <typename E>
+struct token {
+    std::string_view name;
+    E value;
+};
+
+////////////////
+// perfect hash
+////////////////
+
+// hash and displace table of the tokens, the tokens are distributed into
+// buckets, and every bucket gets a seed which places its tokens into free
+// slots of the table
+template <auto& Tokens, bool CaseInsensitive>
+struct perfect_hash {
+    constexpr static size_t size = std::size(Tokens);
+
+    constexpr static size_t power_of_two(size_t n) {
+        size_t result = 1;
+        while (result < n) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    constexpr static size_t bucket_count = power_of_two(size);
+    constexpr static size_t slot_count = power_of_two(2 * size);
+    constexpr static uint32_t max_seed = 1 << 16;
+
+    constexpr static char lower(char c) {
+        if constexpr (CaseInsensitive) {
+            return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+        } else {
+            return c;
+        }
+    }
+
+    // fnv-1a
+    constexpr static uint64_t hash_of(const char* data, size_t size) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(lower(data[i]));
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    constexpr static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    constexpr static size_t bucket_of(uint64_t hash) {
+        return mix(hash) & (bucket_count - 1);
+    }
+
+    constexpr static size_t slot_of(uint64_t hash, uint32_t seed) {
+        return mix(hash + seed * 0x9E3779B97F4A7C15ULL) & (slot_count - 1);
+    }
+
+    constexpr static bool unique_tokens() {
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = i + 1; j < size; ++j) {
+                const auto& a = Tokens[i].name;
+                const auto& b = Tokens[j].name;
+                bool same = a.size() == b.size();
+                for (size_t k = 0; same && k < a.size(); ++k) {
+                    same = lower(a[k]) == lower(b[k]);
+                }
+                if (same) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    struct table {
+        std::array<uint32_t, bucket_count> seeds{};
+        // index of the token within the slot plus one, zero if empty
+        std::array<size_t, slot_count> slots{};
+        bool valid{true};
+    };
+
+    constexpr static bool place_bucket(table& t,
+                                       const std::array<uint64_t, size>& hashes,
+                                       size_t bucket) {
+        for (uint32_t seed = 1; seed < max_seed; ++seed) {
+            std::array<size_t, size> placed{};
+            size_t placed_size = 0;
+            bool fits = true;
+            for (size_t i = 0; fits && i < size; ++i) {
+                if (bucket_of(hashes[i]) != bucket) {
+                    continue;
+                }
+
+                size_t slot = slot_of(hashes[i], seed);
+                fits = t.slots[slot] == 0;
+                for (size_t j = 0; fits && j < placed_size; ++j) {
+                    fits = slot_of(hashes[placed[j]], seed) != slot;
+                }
+                placed[placed_size++] = i;
+            }
+
+            if (fits) {
+                for (size_t j = 0; j < placed_size; ++j) {
+                    t.slots[slot_of(hashes[placed[j]], seed)] = placed[j] + 1;
+                }
+                t.seeds[bucket] = seed;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr static table make_table() {
+        table t{};
+        std::array<uint64_t, size> hashes{};
+        std::array<size_t, bucket_count> bucket_sizes{};
+        size_t max_bucket_size = 0;
+        for (size_t i = 0; i < size; ++i) {
+            hashes[i] = hash_of(Tokens[i].name.data(), Tokens[i].name.size());
+            size_t& bucket_size = bucket_sizes[bucket_of(hashes[i])];
+            ++bucket_size;
+            if (bucket_size > max_bucket_size) {
+                max_bucket_size = bucket_size;
+            }
+        }
+
+        // the largest buckets are placed first, while most slots are free
+        for (size_t bucket_size = max_bucket_size; bucket_size > 0;
+             --bucket_size) {
+            for (size_t b = 0; b < bucket_count; ++b) {
+                if (bucket_sizes[b] == bucket_size &&
+                    !place_bucket(t, hashes, b)) {
+                    t.valid = false;
+                    return t;
+                }
+            }
+        }
+        return t;
+    }
+};
+
+////////////////
+// enum map
+////////////////
+
+// converts columns into enum values using a perfect hash of the tokens
+// built at compile time, every column is hashed once and compared with the
+// only token it can be, the tokens need to be a constexpr array, eg.
+// constexpr ss::token<status> status_tokens[] = {{"OK", status::ok}, ...};
+// p.get_next<ss::enum_map<status_tokens>>();
+template <auto& Tokens, bool CaseInsensitive = false>
+class enum_map {
+    using token_type =
+        std::remove_cv_t<std::remove_reference_t<decltype(Tokens[0])>>;
+    using hash = perfect_hash<Tokens, CaseInsensitive>;
+
+    static_assert(hash::size > 0, "enum_map needs at least one token");
+    static_assert(hash::unique_tokens(), "enum_map tokens need to be unique");
+
+    // equal tokens would never fit into the table, so it is not built
+    constexpr static typename hash::table table_ =
+        hash::unique_tokens() ? hash::make_table() : typename hash::table{};
+    static_assert(table_.valid, "enum_map could not build a perfect hash");
+
+    static bool equal(const char* lhs, const char* rhs, size_t size) {
+        if constexpr (CaseInsensitive) {
+            for (size_t i = 0; i < size; ++i) {
+                if (hash::lower(lhs[i]) != hash::lower(rhs[i])) {
+                    return false;
+                }
+            }
+            return true;
+        } else {
+            return std::memcmp(lhs, rhs, size) == 0;
+        }
+    }
+
+public:
+    using enum_type = decltype(token_type::value);
+
+    // returns false if the text is none of the tokens
+    static bool decode(const char* begin, const char* end, enum_type& value) {
+        size_t size = end - begin;
+        uint64_t h = hash::hash_of(begin, size);
+        size_t seed = table_.seeds[hash::bucket_of(h)];
+        size_t index = table_.slots[hash::slot_of(h, seed)];
+        if (index == 0) {
+            return false;
+        }
+
+        const auto& token = Tokens[index - 1];
+        if (token.name.size() != size ||
+            !equal(token.name.data(), begin, size)) {
+            return false;
+        }
+        value = token.value;
+        return true;
+    }
+};
+
+// same as enum_map, but the tokens are matched ignoring the case of ascii
+// letters
+template <auto& Tokens>
+using enum_map_ci = enum_map<Tokens, true>;
+
+template <typename T>
+struct is_enum_map : std::false_type {};
+
+template <auto& Tokens, bool CaseInsensitive>
+struct is_enum_map<enum_map<Tokens, CaseInsensitive>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_enum_map_v = is_enum_map<T>::value;
+
+} /* ss */
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "type_traits.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <fast_float/fast_float.h>
 #include <functional>
@@ -218,6 +220,103 @@ std::enable_if_t<std::is_integral_v<T>, std::optional<T>> to_num(
     return value;
 }
 
+////////////////
+// bounded number converters
+////////////////
+
+enum class bounded_result : uint8_t { valid, invalid, out_of_range };
+
+// number of digits of the magnitude of the value
+template <typename T>
+constexpr size_t count_digits(T value) {
+    using U = std::make_unsigned_t<T>;
+    U magnitude = (value < 0) ? U(0) - static_cast<U>(value)
+                              : static_cast<U>(value);
+    size_t digits = 1;
+    while (magnitude >= 10) {
+        magnitude /= 10;
+        ++digits;
+    }
+    return digits;
+}
+
+// converts an integer which needs to be within [Min, Max], values with more
+// digits than the bounds allow are rejected before being converted, and
+// the overflow checks are skipped if the number of digits rules them out
+template <typename T, T Min, T Max>
+bounded_result to_num_bounded(const char* begin, const char* end, T& value) {
+    constexpr size_t positive_digits = (Max >= 0) ? count_digits(Max) : 0;
+    constexpr size_t negative_digits = (Min < 0) ? count_digits(Min) : 0;
+    constexpr size_t max_digits = std::max(positive_digits, negative_digits);
+    constexpr bool no_overflow =
+        max_digits <= static_cast<size_t>(std::numeric_limits<T>::digits10);
+
+    if (begin == end) {
+        return bounded_result::invalid;
+    }
+
+    const char* const number_begin = begin;
+    bool is_negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        is_negative = *begin == '-';
+        if (is_negative) {
+            ++begin;
+        }
+    }
+
+    // a sign needs to be followed by digits
+    if (begin == end) {
+        return bounded_result::invalid;
+    }
+
+    // leading zeros do not change the value
+    while (begin != end && *begin == '0') {
+        ++begin;
+    }
+
+    size_t digits = end - begin;
+    if (digits > (is_negative ? negative_digits : positive_digits)) {
+        for (auto i = begin; i != end; ++i) {
+            if (!from_char(*i)) {
+                return bounded_result::invalid;
+            }
+        }
+        return bounded_result::out_of_range;
+    }
+
+    T result = 0;
+    if constexpr (no_overflow) {
+        for (auto i = begin; i != end; ++i) {
+            auto digit = static_cast<unsigned char>(*i - '0');
+            if (digit > 9) {
+                return bounded_result::invalid;
+            }
+            result = static_cast<T>(result * 10 + digit);
+        }
+        if (is_negative) {
+            result = static_cast<T>(-result);
+        }
+    } else {
+        auto optional_result = to_num<T>(number_begin, end);
+        if (!optional_result) {
+            for (auto i = begin; i != end; ++i) {
+                if (!from_char(*i)) {
+                    return bounded_result::invalid;
+                }
+            }
+            // the value does not fit into 'T', so it is out of the bounds
+            return bounded_result::out_of_range;
+        }
+        result = *optional_result;
+    }
+
+    if (result < Min || result > Max) {
+        return bounded_result::out_of_range;
+    }
+    value = result;
+    return bounded_result::valid;
+}
+
 ////////////////
 // extract
 ////////////////
@@ -263,15 +362,85 @@ std::enable_if_t<is_instance_of_v<std::optional, T>, bool> extract(
     return true;
 }
 
+////////////////
+// field classification
+////////////////
+
+// kind of the characters of a field, found with a single pass so that a
+// variant is only extracted by the alternatives which can succeed
+enum class field_kind : uint8_t {
+    empty,
+    // only digits
+    digits,
+    // minus followed by digits
+    negative_digits,
+    // digits, signs, dots and exponents, which may be a floating point value
+    number,
+    other
+};
+
+inline field_kind classify_field(const char* begin, const char* end) {
+    if (begin == end) {
+        return field_kind::empty;
+    }
+
+    bool only_digits = true;
+    for (auto curr = begin + (*begin == '-'); curr != end; ++curr) {
+        char c = *curr;
+        if (c >= '0' && c <= '9') {
+            continue;
+        }
+        if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+            only_digits = false;
+            continue;
+        }
+        return field_kind::other;
+    }
+
+    if (!only_digits) {
+        return field_kind::number;
+    }
+    return (*begin == '-') ? field_kind::negative_digits : field_kind::digits;
+}
+
+// false if the field surely cannot be extracted as 'T', types without a
+// known format are always tried
+template <typename T>
+bool may_extract(field_kind kind, const char* begin, const char* end) {
+    if constexpr (std::is_same_v<T, bool>) {
+        size_t size = end - begin;
+        return (kind == field_kind::digits && size == 1) ||
+               (kind == field_kind::other && (size == 4 || size == 5));
+    } else if constexpr (std::is_same_v<T, char>) {
+        return end == begin + 1;
+    } else if constexpr (std::is_integral_v<T>) {
+        return kind == field_kind::digits ||
+               (std::is_signed_v<T> && kind == field_kind::negative_digits);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (kind == field_kind::other) {
+            // infinity and nan
+            char c = *(begin + (*begin == '-'));
+            return c == 'i' || c == 'I' || c == 'n' || c == 'N';
+        }
+        return kind != field_kind::empty;
+    } else {
+        return true;
+    }
+}
+
 template <typename T, size_t I>
-bool extract_variant(const char* begin, const char* end, T& value) {
+bool extract_variant(const char* begin, const char* end, T& value,
+                     field_kind kind) {
     using IthType = std::variant_alternative_t<I, std::decay_t<T>>;
-    IthType ithValue;
-    if (extract<IthType>(begin, end, ithValue)) {
-        value = ithValue;
-        return true;
-    } else if constexpr (I + 1 < std::variant_size_v<T>) {
-        return extract_variant<T, I + 1>(begin, end, value);
+    if (may_extract<IthType>(kind, begin, end)) {
+        IthType ithValue;
+        if (extract<IthType>(begin, end, ithValue)) {
+            value.template emplace<I>(std::move(ithValue));
+            return true;
+        }
+    }
+    if constexpr (I + 1 < std::variant_size_v<T>) {
+        return extract_variant<T, I + 1>(begin, end, value, kind);
     }
     return false;
 }
@@ -279,7 +448,8 @@ bool extract_variant(const char* begin, const char* end, T& value) {
 template <typename T>
 std::enable_if_t<is_instance_of_v<std::variant, T>, bool> extract(
     const char* begin, const char* end, T& value) {
-    return extract_variant<T, 0>(begin, end, value);
+    return extract_variant<T, 0>(begin, end, value,
+                                 classify_field(begin, end));
 }
 
 ////////////////
@@ -0,0 +1,101 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#if __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ss {
+
+////////////////
+// file watcher
+////////////////
+
+// waits for data to be appended to a file, inotify is used on linux to get
+// notified once the file is modified, the size of the file is also checked
+// in intervals in case inotify is not available or misses a modification
+class file_watcher {
+public:
+    explicit file_watcher(const std::string& file_name,
+                          std::chrono::milliseconds interval =
+                              std::chrono::milliseconds{100})
+        : file_name_{file_name}, interval_{interval} {
+#if __linux__
+        fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ != -1 &&
+            inotify_add_watch(fd_, file_name_.c_str(),
+                              IN_MODIFY | IN_CLOSE_WRITE) == -1) {
+            close(fd_);
+            fd_ = -1;
+        }
+#endif
+    }
+
+    ~file_watcher() {
+#if __linux__
+        if (fd_ != -1) {
+            close(fd_);
+        }
+#endif
+    }
+
+    file_watcher(const file_watcher& other) = delete;
+    file_watcher& operator=(const file_watcher& other) = delete;
+
+    // returns true once the file is larger than the given size, or false
+    // if it is not larger by the deadline
+    bool wait(size_t size, std::chrono::steady_clock::time_point deadline) {
+        using namespace std::chrono;
+        while (true) {
+            std::error_code ec;
+            auto file_size = std::filesystem::file_size(file_name_, ec);
+            if (!ec && file_size > size) {
+                return true;
+            }
+
+            auto now = steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            auto timeout = std::min<steady_clock::duration>(interval_,
+                                                            deadline - now);
+            sleep(duration_cast<milliseconds>(timeout) + milliseconds{1});
+        }
+    }
+
+private:
+    void sleep(std::chrono::milliseconds timeout) {
+#if __linux__
+        if (fd_ != -1) {
+            pollfd fd{fd_, POLLIN, 0};
+            if (poll(&fd, 1, static_cast<int>(timeout.count())) > 0) {
+                // the events are only used to wake up
+                char events[4096];
+                while (read(fd_, events, sizeof(events)) > 0)
+                    ;
+            }
+            return;
+        }
+#endif
+        std::this_thread::sleep_for(timeout);
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string file_name_;
+    std::chrono::milliseconds interval_;
+#if __linux__
+    int fd_{-1};
+#endif
+};
+
+} /* ss */
@@ -0,0 +1,222 @@
+#pragma once
+
+#ifdef __cpp_impl_coroutine
+
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace ss {
+
+////////////////
+// generator
+////////////////
+
+// lazily produced sequence of values which can be iterated over once, the
+// coroutine is resumed each time the iterator is incremented
+template <typename T>
+class generator {
+public:
+    struct promise_type {
+        generator get_return_object() {
+            return generator{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // the yielded value lives until the coroutine is resumed
+        std::suspend_always yield_value(T& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        std::suspend_always yield_value(T&& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        // nothing within the library throws
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        T* value_{nullptr};
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        iterator() = default;
+        explicit iterator(handle coroutine) : coroutine_{coroutine} {}
+
+        T& operator*() const { return *coroutine_.promise().value_; }
+        T* operator->() const { return coroutine_.promise().value_; }
+
+        iterator& operator++() {
+            coroutine_.resume();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return !it.coroutine_ || it.coroutine_.done();
+        }
+
+    private:
+        handle coroutine_{nullptr};
+    };
+
+    explicit generator(handle coroutine) : coroutine_{coroutine} {}
+
+    generator(generator&& other) noexcept
+        : coroutine_{std::exchange(other.coroutine_, nullptr)} {}
+
+    generator& operator=(generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            coroutine_ = std::exchange(other.coroutine_, nullptr);
+        }
+        return *this;
+    }
+
+    generator(const generator& other) = delete;
+    generator& operator=(const generator& other) = delete;
+
+    ~generator() { destroy(); }
+
+    iterator begin() {
+        if (coroutine_) {
+            coroutine_.resume();
+        }
+        return iterator{coroutine_};
+    }
+
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    void destroy() {
+        if (coroutine_) {
+            coroutine_.destroy();
+        }
+    }
+
+    handle coroutine_;
+};
+
+////////////////
+// async generator
+////////////////
+
+// same as the generator, but the coroutine may itself co_await, the next
+// value is requested by co_awaiting next() from another coroutine, which is
+// resumed once the value is yielded, std::nullopt is returned at the end
+template <typename T>
+class async_generator {
+public:
+    struct promise_type {
+        // resumes the coroutine which is waiting for the value
+        struct transfer {
+            bool await_ready() noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<promise_type> coroutine) noexcept {
+                return coroutine.promise().consumer_;
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        async_generator get_return_object() {
+            return async_generator{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        transfer final_suspend() noexcept { return {}; }
+
+        transfer yield_value(T& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        transfer yield_value(T&& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept { value_ = nullptr; }
+
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        T* value_{nullptr};
+        std::coroutine_handle<> consumer_;
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    struct next_awaiter {
+        bool await_ready() noexcept {
+            return !coroutine_ || coroutine_.done();
+        }
+
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<> consumer) noexcept {
+            coroutine_.promise().consumer_ = consumer;
+            return coroutine_;
+        }
+
+        std::optional<T> await_resume() {
+            if (!coroutine_ || coroutine_.done()) {
+                return std::nullopt;
+            }
+            return std::move(*coroutine_.promise().value_);
+        }
+
+        handle coroutine_;
+    };
+
+    explicit async_generator(handle coroutine) : coroutine_{coroutine} {}
+
+    async_generator(async_generator&& other) noexcept
+        : coroutine_{std::exchange(other.coroutine_, nullptr)} {}
+
+    async_generator& operator=(async_generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            coroutine_ = std::exchange(other.coroutine_, nullptr);
+        }
+        return *this;
+    }
+
+    async_generator(const async_generator& other) = delete;
+    async_generator& operator=(const async_generator& other) = delete;
+
+    ~async_generator() { destroy(); }
+
+    next_awaiter next() { return next_awaiter{coroutine_}; }
+
+private:
+    void destroy() {
+        if (coroutine_) {
+            coroutine_.destroy();
+        }
+    }
+
+    handle coroutine_;
+};
+
+} /* ss */
+
+#endif
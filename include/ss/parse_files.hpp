@@ -0,0 +1,103 @@
+#pragma once
+
+#include "parser.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// parse files
+////////////////
+
+// parses multiple files using a work stealing thread pool, the function is
+// invoked with a parser of each file and may be invoked from multiple
+// threads at once, the files are scheduled from the largest to the smallest
+// so that the workers finish at about the same time, every worker keeps its
+// parser and opens the next file with it so that the buffers are reused,
+// the results of the function are returned in the order of the files
+template <typename... Matchers, typename Fun>
+auto parse_files(const std::vector<std::string>& paths, Fun&& fun,
+                 size_t threads = std::thread::hardware_concurrency(),
+                 const std::string& delim = ss::default_delimiter) {
+    using result = std::invoke_result_t<Fun&, parser<Matchers...>&>;
+    constexpr static bool has_result = !std::is_void_v<result>;
+
+    std::vector<uintmax_t> sizes(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::error_code ec;
+        sizes[i] = std::filesystem::file_size(paths[i], ec);
+        if (ec) {
+            sizes[i] = 0;
+        }
+    }
+
+    std::vector<size_t> order(paths.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    // not a std::vector<bool>, whose elements cannot be written to from
+    // multiple threads at once
+    std::vector<std::optional<ternary_t<has_result, result, none>>> results;
+    if constexpr (has_result) {
+        results.resize(paths.size());
+    }
+
+    {
+        thread_pool pool{std::min(threads, std::max<size_t>(paths.size(), 1))};
+        std::vector<std::optional<parser<Matchers...>>> parsers(pool.size());
+        for (size_t i : order) {
+            pool.push([&, i](size_t worker) {
+                auto& p = parsers[worker];
+                if (p.has_value()) {
+                    p->open(paths[i]);
+                } else {
+                    p.emplace(paths[i], delim);
+                }
+
+                if constexpr (has_result) {
+                    results[i].emplace(fun(*p));
+                } else {
+                    fun(*p);
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    if constexpr (has_result) {
+        std::vector<result> ordered;
+        ordered.reserve(results.size());
+        for (auto& r : results) {
+            ordered.push_back(std::move(*r));
+        }
+        return ordered;
+    }
+}
+
+// concatenates the results of multiple files in their order
+template <typename T>
+std::vector<T> merge_results(std::vector<std::vector<T>> results) {
+    size_t size = 0;
+    for (const auto& r : results) {
+        size += r.size();
+    }
+
+    std::vector<T> merged;
+    merged.reserve(size);
+    for (auto& r : results) {
+        std::move(r.begin(), r.end(), std::back_inserter(merged));
+    }
+    return merged;
+}
+
+} /* ss */
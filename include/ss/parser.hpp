@@ -3,11 +3,22 @@
 #include "common.hpp"
 #include "converter.hpp"
 #include "extract.hpp"
+#include "file_watcher.hpp"
+#include "generator.hpp"
+#include "quarantine.hpp"
 #include "restrictions.hpp"
+#include "row_view.hpp"
+#include "transcoder.hpp"
+#include "utf8.hpp"
+#include "zone_map.hpp"
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ss {
@@ -19,16 +30,20 @@ class parser {
     using multiline = typename setup<Matchers...>::multiline;
     using error_type = ss::ternary_t<string_error, std::string, bool>;
 
-    constexpr static bool escaped_multiline_enabled =
-        multiline::enabled && setup<Matchers...>::escape::enabled;
-
-    constexpr static bool quoted_multiline_enabled =
-        multiline::enabled && setup<Matchers...>::quote::enabled;
+    using comment = typename setup<Matchers...>::comment;
+    constexpr static bool ignore_empty = setup<Matchers...>::ignore_empty;
+    constexpr static bool quarantine = setup<Matchers...>::quarantine;
+    constexpr static bool utf8 = setup<Matchers...>::utf8;
+    constexpr static bool follow = setup<Matchers...>::follow;
 
 public:
+    // the file is converted to utf-8 while it is read unless its encoding is
+    // utf-8, if the encoding is detected it is given by the byte order mark,
+    // the byte order mark is never a part of the first row
     parser(const std::string& file_name,
-           const std::string& delim = ss::default_delimiter)
-        : file_name_{file_name}, reader_{file_name_, delim} {
+           const std::string& delim = ss::default_delimiter,
+           ss::encoding encoding = ss::encoding::detect)
+        : file_name_{file_name}, reader_{file_name_, delim, encoding} {
         if (reader_.file_) {
             read_line();
         } else {
@@ -59,7 +74,65 @@ public:
 
     bool eof() const { return eof_; }
 
-    bool ignore_next() { return reader_.read_next(); }
+    // skips the next row without splitting or converting it, returns false
+    // if eof
+    bool ignore_next() {
+        read_line();
+        return !eof_;
+    }
+
+    // dictionary in which the values of 'dict_string' columns are stored
+    ss::dictionary& dictionary() {
+        return reader_.converter_.dictionary();
+    }
+
+    // arena in which the values of 'arena_string' columns are stored,
+    // clearing it invalidates all the previously converted values
+    ss::arena& arena() {
+        return reader_.converter_.arena();
+    }
+
+    // rows for which the predicate returns false are skipped without
+    // converting the other columns, the predicate is invoked with the
+    // unquoted and unescaped value of the column as a std::string_view, or
+    // with the value of the column converted to 'T', rows in which the
+    // column cannot be converted are skipped as well, while rows which
+    // cannot be split or have too few columns are kept so that the error
+    // gets reported
+    template <size_t Column, typename T = std::string_view, typename Fun>
+    void where(Fun&& fun) {
+        reader_.filters_.emplace_back(
+            [fun = std::forward<Fun>(fun)](converter<Matchers...>& c) mutable {
+                if (!c.splitter_.valid() ||
+                    Column >= c.splitter_.split_data_.size()) {
+                    return true;
+                }
+
+                if constexpr (std::is_same_v<T, std::string_view>) {
+                    auto [begin, end] = c.splitter_.split_data_[Column];
+                    return static_cast<bool>(
+                        fun(std::string_view{begin, static_cast<size_t>(
+                                                        end - begin)}));
+                } else {
+                    auto value = c.template convert_column<T>(Column);
+                    return c.valid() && static_cast<bool>(fun(value));
+                }
+            });
+
+        // the next row is already read, so it needs to be checked as well
+        if (!eof_ && !reader_.matches_filters()) {
+            read_line();
+        }
+    }
+
+    // rows which cannot be converted are passed to the sink, rows converted
+    // using try_next or try_object are not, since they may be converted by
+    // one of the alternatives
+    void set_quarantine_sink(ss::quarantine_sink& sink) {
+        static_assert(quarantine, "'quarantine' needs to be enabled to use "
+                                  "a quarantine sink");
+        sink_ = &sink;
+    }
 
     template <typename T, typename... Ts>
     T get_object() {
@@ -68,6 +141,97 @@ public:
 
     template <typename T, typename... Ts>
     no_void_validator_tup_t<T, Ts...> get_next() {
+        return get_next_impl<false, T, Ts...>();
+    }
+
+    // position of the next row, can be used to return to it using seek
+    ss::position position() const {
+        return reader_.next_line_position_;
+    }
+
+    // continues reading from the given position
+    void seek(const ss::position& position) {
+        if (!reader_.file_) {
+            return;
+        }
+        reader_.seek(position);
+        read_line();
+    }
+
+    // continues with another file, the buffers are kept so that parsing
+    // many files with the same parser does not allocate them again, the
+    // delimiter stays the same, while the filters, the quarantine sink and
+    // the restrictions are removed
+    void open(const std::string& file_name,
+              ss::encoding encoding = ss::encoding::detect) {
+        file_name_ = file_name;
+        clear_error();
+        // the filters may refer to the state of the previous file
+        reader_.filters_.clear();
+        sink_ = nullptr;
+        // the watcher of the previous file would never see the new rows
+        watcher_.reset();
+        reader_.open(file_name_, encoding);
+        if (reader_.file_) {
+            read_line();
+        } else {
+            set_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    // waits until a new row is appended to the file once the end of the
+    // file is reached, returns false if there is none within the timeout,
+    // reading continues from the position at which it stopped, the rows at
+    // the end of the file which are not terminated by a new line yet are
+    // read only once the rest of them is appended
+    bool wait_for_rows(std::chrono::milliseconds timeout) {
+        static_assert(follow, "'follow' needs to be enabled to wait for rows");
+        if (!eof_) {
+            return true;
+        }
+        if (!reader_.file_) {
+            return false;
+        }
+
+        if (!watcher_) {
+            watcher_ = std::make_unique<file_watcher>(file_name_);
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            size_t end = reader_.offset_;
+            reader_.seek(reader_.next_line_position_);
+            read_line();
+            if (!eof_) {
+                clear_error();
+                return true;
+            }
+            end = std::max(end, reader_.offset_);
+            if (!watcher_->wait(end, deadline)) {
+                return false;
+            }
+        }
+    }
+
+    // only the rows within the given ranges are read, the ranges need to be
+    // ordered by their positions, the row counts need to be made using the
+    // same setup and without filters
+    void restrict_to(std::vector<ss::row_range> ranges) {
+        if (!reader_.file_) {
+            return;
+        }
+        reader_.ranges_ = std::move(ranges);
+        reader_.next_range_ = 0;
+        reader_.rows_left_ = 0;
+        reader_.restricted_ = true;
+        read_line();
+    }
+
+    // reads the next row without converting it, the columns are converted
+    // once requested from the returned view, which is valid until the next
+    // row is read, the view of an invalid row keeps the error of the row
+    row_view<Matchers...> next_row() {
         reader_.update();
         clear_error();
         if (eof_) {
@@ -75,14 +239,47 @@ public:
             return {};
         }
 
-        auto value = reader_.converter_.template convert<T, Ts...>();
-
-        if (!reader_.converter_.valid()) {
+        reader_.split();
+        if (!reader_.check_multiline_limit()) {
+            set_error_invalid_conversion();
+            quarantine_row();
+        } else if (!reader_.converter_.splitter_.valid()) {
+            reader_.converter_.set_error_unterminated_quote();
             set_error_invalid_conversion();
+            quarantine_row();
+        } else if (!reader_.check_utf8()) {
+            set_error_invalid_conversion();
+            quarantine_row();
         }
 
         read_line();
-        return value;
+        return row_view<Matchers...>{&reader_.converter_, error_};
+    }
+
+    // builds the zone map of the given column from the rest of the file,
+    // only the column is converted, rows which are invalid or whose column
+    // cannot be converted are counted as nulls
+    template <typename T>
+    ss::zone_map<T> build_zone_map(size_t column,
+                                   size_t zone_rows = ss::default_zone_rows) {
+        ss::zone_map<T> zm{zone_rows};
+        while (!eof_) {
+            auto row_position = position();
+            next_row();
+            if (!valid()) {
+                zm.add_null(row_position);
+                continue;
+            }
+
+            auto& c = reader_.converter_;
+            auto value = c.template convert_column<T>(column);
+            if (c.valid()) {
+                zm.add(row_position, value);
+            } else {
+                zm.add_null(row_position);
+            }
+        }
+        return zm;
     }
 
     ////////////////
@@ -152,6 +349,17 @@ public:
         return iterable<true, Ts...>{this};
     }
 
+#ifdef __cpp_impl_coroutine
+    // generator of the remaining rows, the rows are read once requested, the
+    // validity of each row can be checked using the valid method
+    template <typename... Ts>
+    generator<no_void_validator_tup_t<Ts...>> rows() {
+        while (!eof_) {
+            co_yield get_next<Ts...>();
+        }
+    }
+#endif
+
     ////////////////
     // composite conversion
     ////////////////
@@ -235,8 +443,14 @@ public:
         template <typename U, typename... Us>
         no_void_validator_tup_t<U, Us...> try_same() {
             parser_.clear_error();
-            auto value =
-                parser_.reader_.converter_.template convert<U, Us...>();
+            // the first conversion of the row is not memoized, so rows which
+            // need no alternatives are not slowed down
+            auto& c = parser_.reader_.converter_;
+            c.memoize(true);
+            auto value = c.template convert<U, Us...>();
+            c.memoize(false);
+            parser_.reader_.check_utf8();
+            parser_.reader_.check_multiline_limit();
             if (!parser_.reader_.converter_.valid()) {
                 parser_.set_error_invalid_conversion();
             }
@@ -257,19 +471,61 @@ public:
     composite<std::optional<no_void_validator_tup_t<Ts...>>> try_next(
         Fun&& fun = none{}) {
         using Ret = no_void_validator_tup_t<Ts...>;
-        return try_invoke_and_make_composite<
-            std::optional<Ret>>(get_next<Ts...>(), std::forward<Fun>(fun));
+        return try_invoke_and_make_composite<std::optional<Ret>>(
+            get_next_impl<true, Ts...>(), std::forward<Fun>(fun));
     }
 
     // identical to try_next but returns composite with object instead of a
     // tuple
     template <typename T, typename... Ts, typename Fun = none>
     composite<std::optional<T>> try_object(Fun&& fun = none{}) {
-        return try_invoke_and_make_composite<
-            std::optional<T>>(get_object<T, Ts...>(), std::forward<Fun>(fun));
+        return try_invoke_and_make_composite<std::optional<T>>(
+            to_object<T>(get_next_impl<true, Ts...>()),
+            std::forward<Fun>(fun));
     }
 
 private:
+    // the rows converted by try_next and try_object may be converted again by
+    // the alternatives of the composite, so they are not quarantined
+    template <bool Composite, typename T, typename... Ts>
+    no_void_validator_tup_t<T, Ts...> get_next_impl() {
+        reader_.update();
+        clear_error();
+        if (eof_) {
+            set_error_eof_reached();
+            return {};
+        }
+
+        reader_.split();
+        auto value = reader_.converter_.template convert<T, Ts...>();
+        reader_.check_utf8();
+        reader_.check_multiline_limit();
+
+        if (!reader_.converter_.valid()) {
+            set_error_invalid_conversion();
+            if constexpr (!Composite) {
+                quarantine_row();
+            }
+        }
+
+        read_line();
+        return value;
+    }
+
+    ////////////////
+    // quarantine
+    ////////////////
+
+    void quarantine_row() {
+        if constexpr (quarantine) {
+            if (sink_) {
+                const auto& c = reader_.converter_;
+                sink_->add(reader_.raw_, reader_.line_number_, c.error_code_,
+                           c.error_column_);
+            }
+        }
+    }
+
     // tries to invoke the given function (see below), if the function
     // returns a value which can be used as a conditional, and it returns
     // false, the function sets an error, and allows the invoke of the
@@ -378,8 +634,14 @@ private:
     void read_line() { eof_ = !reader_.read_next(); }
 
     struct reader {
-        reader(const std::string& file_name_, const std::string& delim)
-            : delim_{delim}, file_{fopen(file_name_.c_str(), "rb")} {}
+        reader(const std::string& file_name_, const std::string& delim,
+               ss::encoding encoding)
+            : delim_{delim}, file_{fopen(file_name_.c_str(), "rb")} {
+            share_storage();
+            if (file_) {
+                skip_bom(encoding);
+            }
+        }
 
         reader(reader&& other)
             : buffer_{other.buffer_},
@@ -387,10 +649,24 @@ private:
               helper_buffer_{other.helper_buffer_}, converter_{std::move(
                                                         other.converter_)},
               next_line_converter_{std::move(other.next_line_converter_)},
-              size_{other.size_}, next_line_size_{other.size_},
+              size_{other.size_}, next_line_size_{other.next_line_size_},
               helper_size_{other.helper_size_}, delim_{std::move(other.delim_)},
-              file_{other.file_}, crlf_{other.crlf_}, line_number_{
-                                                          other.line_number_} {
+              file_{other.file_}, transcoder_{std::move(other.transcoder_)},
+              crlf_{other.crlf_},
+              line_number_{other.line_number_}, offset_{other.offset_},
+              next_line_position_{other.next_line_position_},
+              split_{other.split_}, next_line_split_{other.next_line_split_},
+              filters_{std::move(other.filters_)},
+              ranges_{std::move(other.ranges_)},
+              next_range_{other.next_range_}, rows_left_{other.rows_left_},
+              restricted_{other.restricted_},
+              invalid_utf8_{other.invalid_utf8_},
+              next_line_invalid_utf8_{other.next_line_invalid_utf8_},
+              limit_reached_{other.limit_reached_},
+              next_line_limit_reached_{other.next_line_limit_reached_},
+              raw_{std::move(other.raw_)},
+              next_line_raw_{std::move(other.next_line_raw_)},
+              scanner_{std::move(other.scanner_)} {
             other.buffer_ = nullptr;
             other.next_line_buffer_ = nullptr;
             other.helper_buffer_ = nullptr;
@@ -409,8 +685,25 @@ private:
                 helper_size_ = other.helper_size_;
                 delim_ = std::move(other.delim_);
                 file_ = other.file_;
+                transcoder_ = std::move(other.transcoder_);
                 crlf_ = other.crlf_;
                 line_number_ = other.line_number_;
+                offset_ = other.offset_;
+                next_line_position_ = other.next_line_position_;
+                split_ = other.split_;
+                next_line_split_ = other.next_line_split_;
+                filters_ = std::move(other.filters_);
+                ranges_ = std::move(other.ranges_);
+                next_range_ = other.next_range_;
+                rows_left_ = other.rows_left_;
+                restricted_ = other.restricted_;
+                invalid_utf8_ = other.invalid_utf8_;
+                next_line_invalid_utf8_ = other.next_line_invalid_utf8_;
+                limit_reached_ = other.limit_reached_;
+                next_line_limit_reached_ = other.next_line_limit_reached_;
+                raw_ = std::move(other.raw_);
+                next_line_raw_ = std::move(other.next_line_raw_);
+                scanner_ = std::move(other.scanner_);
 
                 other.buffer_ = nullptr;
                 other.next_line_buffer_ = nullptr;
@@ -435,103 +728,240 @@ private:
         reader(const reader& other) = delete;
         reader& operator=(const reader& other) = delete;
 
+        // reads the next record which matches the filters, the record is
+        // split only once it needs to be converted or filtered
         bool read_next() {
-            ++line_number_;
-            memset(next_line_buffer_, '\0', next_line_size_);
-            ssize_t ssize =
-                get_line(&next_line_buffer_, &next_line_size_, file_);
+            while (read_record()) {
+                next_line_split_ = false;
+                if (matches_filters()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool matches_filters() {
+            if (filters_.empty()) {
+                return true;
+            }
 
-            if (ssize == -1) {
+            if (!next_line_split_) {
+                next_line_converter_.split(next_line_buffer_, delim_);
+                next_line_split_ = true;
+            }
+            for (auto& filter : filters_) {
+                if (!filter(next_line_converter_)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // reads the next record, empty and comment lines are skipped if
+        // enabled
+        bool read_record() {
+            if (restricted_ && !enter_range()) {
                 return false;
             }
 
-            size_t size = remove_eol(next_line_buffer_, ssize);
-            size_t limit = 0;
+            size_t size;
+            do {
+                next_line_position_ = {offset_, line_number_};
+                ++line_number_;
+                ssize_t ssize =
+                    read_file_line(&next_line_buffer_, &next_line_size_);
 
-            if constexpr (escaped_multiline_enabled) {
-                while (escaped_eol(size)) {
-                    if (multiline_limit_reached(limit)) {
-                        return true;
-                    }
-                    if (!append_next_line_to_buffer(next_line_buffer_, size)) {
-                        remove_eol(next_line_buffer_, ssize);
-                        next_line_converter_.set_error_unterminated_escape();
-                        return true;
-                    }
+                if (ssize == -1 || !line_complete(next_line_buffer_, ssize)) {
+                    return false;
                 }
-            }
 
-            next_line_converter_.split(next_line_buffer_, delim_);
+                size = remove_eol(next_line_buffer_, ssize);
+            } while (ignored(next_line_buffer_, size));
 
-            if constexpr (quoted_multiline_enabled) {
-                while (unterminated_quote()) {
+            if constexpr (multiline::enabled) {
+                size_t line_begin = 0;
+                size_t limit = 0;
+                next_line_limit_reached_ = false;
+                while (!scanner_.scan(next_line_buffer_ + line_begin,
+                                      next_line_buffer_ + size)) {
                     if (multiline_limit_reached(limit)) {
-                        return true;
-                    }
-                    if (!append_next_line_to_buffer(next_line_buffer_, size)) {
-                        remove_eol(next_line_buffer_, ssize);
-                        return true;
+                        // the error is reported once the record is split
+                        scanner_.reset();
+                        break;
                     }
-
-                    if constexpr (escaped_multiline_enabled) {
-                        while (escaped_eol(size)) {
-                            if (multiline_limit_reached(limit)) {
-                                return true;
-                            }
-                            if (!append_next_line_to_buffer(next_line_buffer_,
-                                                            size)) {
-                                remove_eol(next_line_buffer_, ssize);
-                                next_line_converter_
-                                    .set_error_unterminated_escape();
-                                return true;
-                            }
+                    if (!append_next_line_to_buffer(next_line_buffer_, size,
+                                                    line_begin)) {
+                        scanner_.reset();
+                        if constexpr (follow) {
+                            // the rest of the record is not written yet
+                            return false;
                         }
+                        break;
                     }
+                }
+            }
 
-                    next_line_converter_.resplit(next_line_buffer_, size);
+            if constexpr (utf8) {
+                // the whole record is validated at once before it is split
+                size_t position = find_invalid_utf8(next_line_buffer_, size);
+                next_line_invalid_utf8_.reset();
+                if (position != size) {
+                    next_line_invalid_utf8_ = position;
                 }
             }
 
+            if constexpr (quarantine) {
+                // the record is unescaped in place once split, so it is
+                // copied before, as it is after being converted to utf-8
+                next_line_raw_.assign(next_line_buffer_, size);
+            }
+
+            return true;
+        }
+
+        // seeks to the next range once all the rows of the current one
+        // are read, returns false if there are no ranges left
+        bool enter_range() {
+            while (rows_left_ == 0) {
+                if (next_range_ == ranges_.size()) {
+                    next_line_position_ = {offset_, line_number_};
+                    return false;
+                }
+
+                const auto& range = ranges_[next_range_++];
+                if (range.begin.offset != offset_) {
+                    seek(range.begin);
+                }
+                rows_left_ = range.rows;
+            }
+            --rows_left_;
             return true;
         }
 
+        void seek(const ss::position& position) {
+            fseek(file_, position.offset, SEEK_SET);
+            transcoder_.reset();
+            offset_ = position.offset;
+            line_number_ = position.line_number;
+            next_line_position_ = position;
+            scanner_.reset();
+        }
+
+        void open(const std::string& file_name, ss::encoding encoding) {
+            if (file_) {
+                fclose(file_);
+            }
+            file_ = fopen(file_name.c_str(), "rb");
+
+            line_number_ = 0;
+            offset_ = 0;
+            next_line_position_ = {};
+            split_ = false;
+            next_line_split_ = false;
+            ranges_.clear();
+            next_range_ = 0;
+            rows_left_ = 0;
+            restricted_ = false;
+            invalid_utf8_.reset();
+            next_line_invalid_utf8_.reset();
+            limit_reached_ = false;
+            next_line_limit_reached_ = false;
+            scanner_.reset();
+            transcoder_ = transcoder{};
+            share_storage();
+            if (file_) {
+                skip_bom(encoding);
+            }
+        }
+
+        // both converters use the same dictionary and arena before anything
+        // is converted, so that the values interned by the filters, which
+        // convert the next line, match the values of the returned rows
+        void share_storage() {
+            converter_.dictionary();
+            converter_.arena();
+            converter_.share_storage(next_line_converter_);
+        }
+
         void update() {
             std::swap(buffer_, next_line_buffer_);
             std::swap(size_, next_line_size_);
             std::swap(converter_, next_line_converter_);
+            std::swap(split_, next_line_split_);
+            std::swap(invalid_utf8_, next_line_invalid_utf8_);
+            std::swap(limit_reached_, next_line_limit_reached_);
+            std::swap(raw_, next_line_raw_);
         }
 
-        bool multiline_limit_reached(size_t& limit) {
+        // rows containing invalid utf-8 are invalid even if their columns
+        // could be converted
+        bool check_utf8() {
+            if constexpr (utf8) {
+                if (invalid_utf8_) {
+                    converter_.set_error_invalid_utf8(*invalid_utf8_);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // records cut off by the multiline limit are invalid, the error
+        // replaces the one reported by the splitter or the conversion
+        bool check_multiline_limit() {
             if constexpr (multiline::size > 0) {
-                if (limit++ >= multiline::size) {
-                    next_line_converter_.set_error_multiline_limit_reached();
-                    return true;
+                if (limit_reached_) {
+                    converter_.set_error_multiline_limit_reached();
+                    return false;
                 }
             }
-            return false;
+            return true;
         }
 
-        bool escaped_eol(size_t size) {
-            const char* curr;
-            for (curr = next_line_buffer_ + size - 1;
-                 curr >= next_line_buffer_ &&
-                 setup<Matchers...>::escape::match(*curr);
-                 --curr) {
+        // the line is split in place, so it must not be split twice
+        void split() {
+            if (!split_) {
+                converter_.split(buffer_, delim_);
+                split_ = true;
             }
-            return (next_line_buffer_ - curr + size) % 2 == 0;
         }
 
-        bool unterminated_quote() {
-            if (next_line_converter_.unterminated_quote()) {
+        // in follow mode the last line of the file is not complete unless
+        // it ends with a new line, since the rest of it may still be written
+        bool line_complete(const char* const line, ssize_t size) {
+            if constexpr (follow) {
+                return size != 0 && line[size - 1] == '\n';
+            } else {
+                (void)line;
+                (void)size;
                 return true;
             }
+        }
+
+        bool ignored(const char* const line, size_t size) {
+            if constexpr (ignore_empty) {
+                if (size == 0) {
+                    return true;
+                }
+            }
+            if constexpr (comment::enabled) {
+                if (size != 0 && comment::match(line[0])) {
+                    return true;
+                }
+            }
             return false;
         }
 
-        void undo_remove_eol(char* buffer, size_t& string_end) {
-            if (next_line_converter_.unterminated_quote()) {
-                string_end -= next_line_converter_.size_shifted();
+        bool multiline_limit_reached(size_t& limit) {
+            if constexpr (multiline::size > 0) {
+                if (limit++ >= multiline::size) {
+                    next_line_limit_reached_ = true;
+                    return true;
+                }
             }
+            return false;
+        }
+
+        void undo_remove_eol(char* buffer, size_t& string_end) {
             if (crlf_) {
                 std::copy_n("\r\n\0", 3, buffer + string_end);
                 string_end += 2;
@@ -542,12 +972,16 @@ private:
         }
 
         size_t remove_eol(char*& buffer, size_t size) {
+            crlf_ = false;
+            if (size == 0 || buffer[size - 1] != '\n') {
+                // last line of the file
+                return size;
+            }
+
             size_t new_size = size - 1;
             if (size >= 2 && buffer[size - 2] == '\r') {
                 crlf_ = true;
                 new_size--;
-            } else {
-                crlf_ = false;
             }
 
             buffer[new_size] = '\0';
@@ -563,16 +997,57 @@ private:
             first_size += second_size;
         }
 
-        bool append_next_line_to_buffer(char*& buffer, size_t& size) {
-            undo_remove_eol(buffer, size);
+        // reads the next line converted to utf-8 and moves the offset by
+        // the size of the line within the file
+        ssize_t read_file_line(char** buffer, size_t* size) {
+            if (transcoder_.enabled()) {
+                size_t file_size;
+                ssize_t ssize =
+                    transcoder_.get_line(buffer, size, file_, file_size);
+                if (ssize != -1) {
+                    offset_ += file_size;
+                }
+                return ssize;
+            }
+
+            ssize_t ssize = get_line(buffer, size, file_);
+            if (ssize != -1) {
+                offset_ += ssize;
+            }
+            return ssize;
+        }
+
+        void skip_bom(ss::encoding encoding) {
+            unsigned char bom[3];
+            size_t size = fread(bom, 1, sizeof(bom), file_);
+            size_t bom_size;
+            ss::encoding detected = detect_encoding(bom, size, bom_size);
+            if (encoding == ss::encoding::detect) {
+                encoding = detected;
+            } else if (encoding != detected) {
+                // the mark of a different encoding is not skipped
+                bom_size = 0;
+            }
 
-            ssize_t next_ssize =
-                get_line(&helper_buffer_, &helper_size_, file_);
-            if (next_ssize == -1) {
+            fseek(file_, bom_size, SEEK_SET);
+            offset_ = bom_size;
+            next_line_position_ = {offset_, 0};
+            transcoder_ = transcoder{encoding};
+        }
+
+        // appends the next line keeping the new line characters between,
+        // sets line_begin to the beginning of the appended line
+        bool append_next_line_to_buffer(char*& buffer, size_t& size,
+                                        size_t& line_begin) {
+            ssize_t next_ssize = read_file_line(&helper_buffer_, &helper_size_);
+            if (next_ssize == -1 ||
+                !line_complete(helper_buffer_, next_ssize)) {
                 return false;
             }
 
             ++line_number_;
+            undo_remove_eol(buffer, size);
+            line_begin = size;
             size_t next_size = remove_eol(helper_buffer_, next_ssize);
             realloc_concat(buffer, size, helper_buffer_, next_size);
             return true;
@@ -594,9 +1069,34 @@ private:
 
         std::string delim_;
         FILE* file_{nullptr};
+        transcoder transcoder_;
 
         bool crlf_;
         size_t line_number_{0};
+
+        size_t offset_{0};
+        ss::position next_line_position_;
+
+        bool split_{false};
+        bool next_line_split_{false};
+        std::vector<std::function<bool(converter<Matchers...>&)>> filters_;
+
+        std::vector<ss::row_range> ranges_;
+        size_t next_range_{0};
+        size_t rows_left_{0};
+        bool restricted_{false};
+
+        // position of the first invalid byte of the record
+        std::optional<size_t> invalid_utf8_;
+        std::optional<size_t> next_line_invalid_utf8_;
+        bool limit_reached_{false};
+        bool next_line_limit_reached_{false};
+
+        // unsplit records, kept only if quarantine is enabled
+        std::string raw_;
+        std::string next_line_raw_;
+
+        record_scanner<Matchers...> scanner_{delim_};
     };
 
     ////////////////
@@ -607,6 +1107,15 @@ private:
     error_type error_{};
     reader reader_;
     bool eof_{false};
+
+    ss::quarantine_sink* sink_{nullptr};
+
+    std::unique_ptr<file_watcher> watcher_;
 };
 
+// parser of files whose columns have fixed widths, the widths are given
+// first, eg. fixed_width_parser<ss::widths<10, 4, 12>, ss::trim<' '>>
+template <typename Widths, typename... Matchers>
+using fixed_width_parser = parser<Widths, Matchers...>;
+
 } /* ss */
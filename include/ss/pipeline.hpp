@@ -0,0 +1,446 @@
+#pragma once
+
+#include "common.hpp"
+#include "converter.hpp"
+#include "thread_pool.hpp"
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// pipeline
+////////////////
+
+// parses a file using multiple threads, the calling thread reads the file and
+// finds the boundaries of the records, while the splitting and the conversion
+// of batches of records is done within a work stealing thread pool
+template <typename... Matchers>
+class pipeline {
+    constexpr static auto string_error = setup<Matchers...>::string_error;
+
+    using multiline = typename setup<Matchers...>::multiline;
+    using comment = typename setup<Matchers...>::comment;
+    constexpr static bool ignore_empty = setup<Matchers...>::ignore_empty;
+
+    static_assert(!setup<Matchers...>::quarantine,
+                  "quarantine is not supported by the pipeline");
+    static_assert(!setup<Matchers...>::follow,
+                  "follow is not supported by the pipeline");
+
+    using error_type = ss::ternary_t<string_error, std::string, bool>;
+
+public:
+    pipeline(const std::string& file_name,
+             const std::string& delim = ss::default_delimiter,
+             size_t threads = std::thread::hardware_concurrency())
+        : file_name_{file_name}, delim_{delim}, threads_{threads},
+          max_batches_{2 * (threads == 0 ? 1 : threads)},
+          file_{fopen(file_name_.c_str(), "rb")} {
+        if (!file_) {
+            set_error_file_not_open();
+            eof_ = true;
+        }
+        // the workers share one dictionary and one arena
+        storage_.dictionary().synchronize();
+        storage_.arena().synchronize();
+    }
+
+    ~pipeline() {
+        free(line_);
+        if (file_) {
+            fclose(file_);
+        }
+    }
+
+    pipeline() = delete;
+    pipeline(const pipeline& other) = delete;
+    pipeline(pipeline&& other) = delete;
+    pipeline& operator=(const pipeline& other) = delete;
+    pipeline& operator=(pipeline&& other) = delete;
+
+    bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else {
+            return !error_;
+        }
+    }
+
+    const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    bool eof() const {
+        return eof_;
+    }
+
+    // dictionary in which the values of 'dict_string' columns are stored,
+    // shared by all the workers and kept until the pipeline is destroyed
+    ss::dictionary& dictionary() {
+        return storage_.dictionary();
+    }
+
+    // arena in which the values of 'arena_string' columns are stored,
+    // shared by all the workers and kept until the pipeline is destroyed
+    ss::arena& arena() {
+        return storage_.arena();
+    }
+
+    // number of records sent to one worker at once
+    void set_batch_size(size_t batch_size) {
+        batch_size_ = (batch_size == 0) ? 1 : batch_size;
+    }
+
+    // the maximum number of batches read but not yet processed, the reading
+    // thread blocks until some of the batches are done once it is reached
+    void set_max_batches(size_t max_batches) {
+        max_batches_ = (max_batches == 0) ? 1 : max_batches;
+    }
+
+    // if enabled (default) the callback is invoked from one thread at a time
+    // in the same order as the records are in the file, otherwise it is
+    // invoked concurrently from the workers as soon as a record is converted
+    void set_ordered(bool ordered) {
+        ordered_ = ordered;
+    }
+
+    // converts every record of the file and invokes the given function with
+    // each valid conversion, the function may accept no arguments, the whole
+    // tuple, or the elements of the tuple, the error of the first invalid
+    // record within the file is kept, no matter which worker finds it first
+    template <typename... Ts, typename Fun>
+    void for_each(Fun&& fun) {
+        run<no_void_validator_tup_t<Ts...>, false, Ts...>(fun);
+    }
+
+    // same as for_each but the function is invoked with a 'T' object
+    template <typename T, typename... Ts, typename Fun>
+    void for_each_object(Fun&& fun) {
+        run<T, true, Ts...>(fun);
+    }
+
+private:
+    ////////////////
+    // batch
+    ////////////////
+
+    struct record {
+        size_t offset;
+        size_t line_number;
+        bool multiline_limit_reached;
+    };
+
+    // records stored one after another, each terminated with '\0'
+    struct batch {
+        std::string data;
+        std::vector<record> records;
+    };
+
+    ////////////////
+    // error
+    ////////////////
+
+    void set_error_file_not_open() {
+        if constexpr (string_error) {
+            error_.append(file_name_).append(" could not be opened.");
+        } else {
+            error_ = true;
+        }
+    }
+
+    void set_error_invalid_record(const std::string& msg, size_t line_number,
+                                  const char* const line) {
+        std::lock_guard lock{error_mutex_};
+        // the workers may find the invalid records in any order
+        if (!valid() && error_line_number_ <= line_number) {
+            return;
+        }
+        error_line_number_ = line_number;
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(" ")
+                .append(std::to_string(line_number))
+                .append(": ")
+                .append(msg)
+                .append(": \"")
+                .append(line)
+                .append("\"");
+        } else {
+            (void)msg;
+            (void)line_number;
+            (void)line;
+            error_ = true;
+        }
+    }
+
+    ////////////////
+    // reading
+    ////////////////
+
+    // size of the new line characters at the end of the data
+    size_t eol_size(const std::string& data, size_t begin) const {
+        size_t size = data.size() - begin;
+        if (size >= 1 && data.back() == '\n') {
+            if (size >= 2 && data[data.size() - 2] == '\r') {
+                return 2;
+            }
+            return 1;
+        }
+        return 0;
+    }
+
+    bool read_line(std::string& data) {
+        ssize_t ssize = get_line(&line_, &line_size_, file_);
+        if (ssize == -1) {
+            return false;
+        }
+        ++line_number_;
+        data.append(line_, ssize);
+        return true;
+    }
+
+    // empty and comment lines, if enabled
+    bool ignored(const std::string& data, size_t begin) const {
+        size_t size = data.size() - begin - eol_size(data, begin);
+        if constexpr (ignore_empty) {
+            if (size == 0) {
+                return true;
+            }
+        }
+        if constexpr (comment::enabled) {
+            if (size != 0 && comment::match(data[begin])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool read_record(batch& b) {
+        size_t begin = b.data.size();
+        do {
+            b.data.resize(begin);
+            if (!read_line(b.data)) {
+                return false;
+            }
+        } while (ignored(b.data, begin));
+
+        bool limit_reached = false;
+        if constexpr (multiline::enabled) {
+            size_t line_begin = begin;
+            size_t limit = 0;
+            while (true) {
+                const char* line = b.data.data() + line_begin;
+                const char* line_end =
+                    b.data.data() + b.data.size() -
+                    eol_size(b.data, line_begin);
+                if (scanner_.scan(line, line_end)) {
+                    break;
+                }
+                if constexpr (multiline::size > 0) {
+                    if (limit++ >= multiline::size) {
+                        scanner_.reset();
+                        limit_reached = true;
+                        break;
+                    }
+                }
+
+                // the new line stays within the record
+                line_begin = b.data.size();
+                if (!read_line(b.data)) {
+                    // unterminated record, the converter reports the error
+                    scanner_.reset();
+                    break;
+                }
+            }
+        }
+
+        b.data.resize(b.data.size() - eol_size(b.data, begin));
+        b.data.push_back('\0');
+        b.records.push_back({begin, line_number_, limit_reached});
+        return true;
+    }
+
+    std::shared_ptr<batch> read_batch() {
+        auto b = std::make_shared<batch>();
+        for (size_t i = 0; i < batch_size_ && read_record(*b); ++i) {
+        }
+        return b;
+    }
+
+    ////////////////
+    // running
+    ////////////////
+
+    template <typename Arg, typename Fun>
+    static void invoke(Arg&& arg, Fun& fun) {
+        if constexpr (std::is_invocable_v<Fun>) {
+            fun();
+        } else if constexpr (std::is_invocable_v<Fun, Arg>) {
+            std::invoke(fun, std::forward<Arg>(arg));
+        } else {
+            std::apply(fun, std::forward<Arg>(arg));
+        }
+    }
+
+    template <typename Value>
+    struct run_state {
+        std::mutex mutex;
+        std::condition_variable batch_done;
+        size_t in_flight{0};
+
+        // ordered merge
+        std::map<size_t, std::vector<Value>> ready;
+        size_t next_to_emit{0};
+        bool emitting{false};
+    };
+
+    template <typename Value, bool get_object, typename... Ts>
+    Value convert(converter<Matchers...>& c, char* line) {
+        if constexpr (get_object) {
+            return to_object<Value>(c.template convert<Ts...>(line, delim_));
+        } else {
+            return c.template convert<Ts...>(line, delim_);
+        }
+    }
+
+    template <typename Value, bool get_object, typename... Ts, typename Fun>
+    void process(batch& b, size_t index, converter<Matchers...>& c,
+                 run_state<Value>& state, Fun& fun) {
+        std::vector<Value> values;
+        if (ordered_) {
+            values.reserve(b.records.size());
+        }
+
+        for (const auto& r : b.records) {
+            char* line = b.data.data() + r.offset;
+            if (r.multiline_limit_reached) {
+                set_error_invalid_record("multiline limit reached.",
+                                         r.line_number, line);
+                continue;
+            }
+
+            auto value = convert<Value, get_object, Ts...>(c, line);
+            if (!c.valid()) {
+                if constexpr (string_error) {
+                    set_error_invalid_record(c.error_msg(), r.line_number,
+                                             line);
+                } else {
+                    set_error_invalid_record({}, r.line_number, line);
+                }
+                continue;
+            }
+
+            if (ordered_) {
+                values.push_back(std::move(value));
+            } else {
+                invoke(std::move(value), fun);
+            }
+        }
+
+        std::unique_lock lock{state.mutex};
+        if (!ordered_) {
+            --state.in_flight;
+            state.batch_done.notify_one();
+            return;
+        }
+
+        // values are emitted by one thread at a time, the thread which
+        // finishes the next batch in order emits all the consecutive ready
+        // batches, the others just leave their values behind
+        state.ready.emplace(index, std::move(values));
+        if (state.emitting) {
+            return;
+        }
+
+        state.emitting = true;
+        while (!state.ready.empty() &&
+               state.ready.begin()->first == state.next_to_emit) {
+            auto node = state.ready.extract(state.ready.begin());
+            lock.unlock();
+            for (auto& value : node.mapped()) {
+                invoke(std::move(value), fun);
+            }
+            lock.lock();
+            ++state.next_to_emit;
+            --state.in_flight;
+            state.batch_done.notify_one();
+        }
+        state.emitting = false;
+    }
+
+    template <typename Value, bool get_object, typename... Ts, typename Fun>
+    void run(Fun& fun) {
+        if (eof_) {
+            return;
+        }
+
+        thread_pool pool{threads_};
+        std::vector<converter<Matchers...>> converters(pool.size());
+        for (auto& c : converters) {
+            c.share_storage(storage_);
+        }
+        run_state<Value> state;
+
+        for (size_t index = 0;; ++index) {
+            auto b = read_batch();
+            if (b->records.empty()) {
+                break;
+            }
+
+            {
+                std::unique_lock lock{state.mutex};
+                state.batch_done.wait(lock, [&] {
+                    return state.in_flight < max_batches_;
+                });
+                ++state.in_flight;
+            }
+
+            pool.push([this, b, index, &converters, &state,
+                       &fun](size_t worker) {
+                process<Value, get_object, Ts...>(*b, index,
+                                                  converters[worker], state,
+                                                  fun);
+            });
+        }
+
+        pool.wait();
+        eof_ = true;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string file_name_;
+    std::string delim_;
+    size_t threads_;
+    size_t batch_size_{1024};
+    size_t max_batches_;
+    bool ordered_{true};
+
+    error_type error_{};
+    size_t error_line_number_{0};
+    std::mutex error_mutex_;
+
+    FILE* file_{nullptr};
+    char* line_{nullptr};
+    size_t line_size_{0};
+    size_t line_number_{0};
+    record_scanner<Matchers...> scanner_{delim_};
+    bool eof_{false};
+
+    // owns the storage shared by the converters of the workers
+    converter<Matchers...> storage_;
+};
+
+} /* ss */
@@ -0,0 +1,108 @@
+#pragma once
+#include "common.hpp"
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// rejected row
+////////////////
+
+// invalid row as found within the file
+struct rejected_row {
+    // bytes of the row without the new line at its end, converted to utf-8
+    // if the file is not encoded as utf-8
+    std::string_view raw;
+    // line number of the last line of the row
+    size_t line_number;
+    error_code code;
+    // index of the column which caused the error, or no_column
+    size_t column;
+};
+
+////////////////
+// quarantine sink
+////////////////
+
+// collects the rows rejected by a parser and hands them over in blocks, the
+// raw bytes of the rows are stored one after another so that a block can be
+// written at once, the views of a block are only valid within the function
+class quarantine_sink {
+public:
+    using block_function =
+        std::function<void(const std::vector<rejected_row>&)>;
+
+    explicit quarantine_sink(block_function fun,
+                             size_t block_size = 64 * 1024)
+        : fun_{std::move(fun)}, block_size_{block_size} {
+        data_.reserve(block_size_);
+    }
+
+    quarantine_sink(const quarantine_sink& other) = delete;
+    quarantine_sink& operator=(const quarantine_sink& other) = delete;
+
+    ~quarantine_sink() {
+        flush();
+    }
+
+    void add(std::string_view raw, size_t line_number, error_code code,
+             size_t column) {
+        entries_.push_back({data_.size(), raw.size(), line_number, code,
+                            column});
+        data_.append(raw);
+        ++rows_;
+        if (data_.size() >= block_size_) {
+            flush();
+        }
+    }
+
+    // passes the collected rows to the function
+    void flush() {
+        if (entries_.empty()) {
+            return;
+        }
+
+        // the data is not appended to any more, so the views stay valid
+        block_.clear();
+        for (const auto& e : entries_) {
+            block_.push_back({std::string_view{data_.data() + e.offset,
+                                               e.size},
+                              e.line_number, e.code, e.column});
+        }
+        fun_(block_);
+
+        entries_.clear();
+        data_.clear();
+    }
+
+    // number of rejected rows so far
+    size_t rows() const {
+        return rows_;
+    }
+
+private:
+    struct entry {
+        size_t offset;
+        size_t size;
+        size_t line_number;
+        error_code code;
+        size_t column;
+    };
+
+    ////////////////
+    // members
+    ////////////////
+
+    block_function fun_;
+    size_t block_size_;
+    std::string data_;
+    std::vector<entry> entries_;
+    std::vector<rejected_row> block_;
+    size_t rows_{0};
+};
+
+} /* ss */
@@ -1,4 +1,6 @@
 #pragma once
+#include <limits>
+#include <type_traits>
 
 namespace ss {
 
@@ -109,6 +111,103 @@ struct oor {
     }
 };
 
+////////////////
+// bounds
+////////////////
+
+// true if the value can be represented as 'T'
+template <typename T, typename U>
+constexpr bool representable(U value) {
+    if constexpr (std::is_signed_v<U> && !std::is_signed_v<T>) {
+        return value >= 0 && static_cast<std::make_unsigned_t<U>>(value) <=
+                                 std::numeric_limits<T>::max();
+    } else if constexpr (!std::is_signed_v<U> && std::is_signed_v<T>) {
+        return value <= static_cast<std::make_unsigned_t<T>>(
+                            std::numeric_limits<T>::max());
+    } else {
+        return value >= std::numeric_limits<T>::min() &&
+               value <= std::numeric_limits<T>::max();
+    }
+}
+
+// integer bounds known at compile time, the exclusive bounds are converted
+// to inclusive ones
+template <typename T, auto Min, auto Max, bool MinExclusive = false,
+          bool MaxExclusive = false>
+struct integer_bounds {
+private:
+    constexpr static bool integral_bounds =
+        std::is_integral_v<decltype(Min)> && std::is_integral_v<decltype(Max)>;
+
+    constexpr static bool valid_bounds() {
+        if constexpr (!std::is_integral_v<T> || std::is_same_v<T, bool> ||
+                      std::is_same_v<T, char> || !integral_bounds) {
+            return false;
+        } else {
+            return representable<T>(Min) && representable<T>(Max) &&
+                   !(MinExclusive &&
+                     static_cast<T>(Min) == std::numeric_limits<T>::max()) &&
+                   !(MaxExclusive &&
+                     static_cast<T>(Max) == std::numeric_limits<T>::min());
+        }
+    }
+
+    template <auto X, bool Exclusive, int Step>
+    constexpr static auto inclusive() {
+        if constexpr (valid_bounds()) {
+            return static_cast<T>(static_cast<T>(X) + Exclusive * Step);
+        } else {
+            return 0;
+        }
+    }
+
+public:
+    constexpr static bool enabled = valid_bounds();
+    constexpr static auto min = inclusive<Min, MinExclusive, 1>();
+    constexpr static auto max = inclusive<Max, MaxExclusive, -1>();
+};
+
+// limits of integers, used as the missing bound of a restriction
+template <typename T>
+constexpr auto min_of() {
+    if constexpr (std::is_integral_v<T>) {
+        return std::numeric_limits<T>::min();
+    } else {
+        return 0;
+    }
+}
+
+template <typename T>
+constexpr auto max_of() {
+    if constexpr (std::is_integral_v<T>) {
+        return std::numeric_limits<T>::max();
+    } else {
+        return 0;
+    }
+}
+
+// inclusive bounds of the integers accepted by a restriction, the value is
+// checked against them while it is parsed
+template <typename T>
+struct bounds {
+    constexpr static bool enabled = false;
+};
+
+template <typename T, auto Min, auto Max>
+struct bounds<ir<T, Min, Max>> : integer_bounds<T, Min, Max> {};
+
+template <typename T, auto N>
+struct bounds<gt<T, N>> : integer_bounds<T, N, max_of<T>(), true> {};
+
+template <typename T, auto N>
+struct bounds<gte<T, N>> : integer_bounds<T, N, max_of<T>()> {};
+
+template <typename T, auto N>
+struct bounds<lt<T, N>> : integer_bounds<T, min_of<T>(), N, false, true> {};
+
+template <typename T, auto N>
+struct bounds<lte<T, N>> : integer_bounds<T, min_of<T>(), N> {};
+
 ////////////////
 // non empty
 ////////////////
@@ -0,0 +1,122 @@
+#pragma once
+#include "converter.hpp"
+#include <any>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+namespace ss {
+
+////////////////
+// row view
+////////////////
+
+// view of a split row, the columns are converted only once requested and the
+// results of the conversions are cached, the view is valid until the next
+// row is read by the parser
+template <typename... Matchers>
+class row_view {
+    constexpr static auto string_error = setup<Matchers...>::string_error;
+
+    using error_type = ss::ternary_t<string_error, std::string, bool>;
+
+public:
+    row_view() = default;
+
+    // the error of the row, if any, is returned by every conversion
+    explicit row_view(converter<Matchers...>* converter,
+                      error_type row_error = {})
+        : converter_{converter}, row_error_{row_error}, error_{row_error} {
+    }
+
+    bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else {
+            return !error_;
+        }
+    }
+
+    const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    // number of columns
+    size_t size() const {
+        return converter_ ? elems().size() : 0;
+    }
+
+    // unconverted value of the column
+    std::string_view operator[](size_t column) const {
+        auto [begin, end] = elems()[column];
+        return {begin, static_cast<size_t>(end - begin)};
+    }
+
+    // converts the column to 'T' once, the same value is returned by every
+    // following call with the same column and type, the validity of the
+    // conversion can be checked with the valid method
+    template <typename T>
+    const no_validator_t<T>& get(size_t column) {
+        for (auto& e : cache_) {
+            if (e.column == column && *e.type == typeid(T)) {
+                error_ = e.error;
+                return std::any_cast<const no_validator_t<T>&>(e.value);
+            }
+        }
+
+        // failed conversions are cached too, columns of an invalid row are
+        // not converted at all
+        std::any value;
+        if (!row_valid()) {
+            value = no_validator_t<T>{};
+            error_ = row_error_;
+        } else {
+            value = converter_->template convert_column<T>(column);
+            if constexpr (string_error) {
+                error_ = converter_->error_msg();
+            } else {
+                error_ = !converter_->valid();
+            }
+        }
+
+        auto& e = cache_.emplace_back(
+            cache_entry{column, &typeid(T), std::move(value), error_});
+        return std::any_cast<const no_validator_t<T>&>(e.value);
+    }
+
+private:
+    struct cache_entry {
+        size_t column;
+        const std::type_info* type;
+        std::any value;
+        error_type error;
+    };
+
+    bool row_valid() const {
+        if constexpr (string_error) {
+            return row_error_.empty();
+        } else {
+            return !row_error_;
+        }
+    }
+
+    const split_data& elems() const {
+        return converter_->splitter_.split_data_;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    converter<Matchers...>* converter_{nullptr};
+
+    // elements of a deque are never moved, references to them stay valid
+    std::deque<cache_entry> cache_;
+    error_type row_error_{};
+    error_type error_{};
+};
+
+} /* ss */
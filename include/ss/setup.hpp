@@ -1,6 +1,7 @@
 #pragma once
 #include "type_traits.hpp"
 #include <array>
+#include <cstdint>
 
 namespace ss {
 
@@ -8,16 +9,20 @@ namespace ss {
 // matcher
 ////////////////
 
+// table of all characters, true if the character is one of the matches
+template <char... Cs>
+inline constexpr std::array<bool, 256> make_match_table() {
+    std::array<bool, 256> table{};
+    for (const auto& c : {Cs...}) {
+        table[static_cast<unsigned char>(c)] = true;
+    }
+    return table;
+}
+
 template <char... Cs>
 struct matcher {
 private:
-    template <char X, char... Xs>
-    static bool match_impl(char c) {
-        if constexpr (sizeof...(Xs) != 0) {
-            return (c == X) || match_impl<Xs...>(c);
-        }
-        return (c == X);
-    }
+    constexpr static std::array<bool, 256> table = make_match_table<Cs...>();
 
     constexpr static bool contains_string_terminator() {
         for (const auto& match : matches) {
@@ -30,7 +35,7 @@ private:
 
 public:
     static bool match(char c) {
-        return match_impl<Cs...>(c);
+        return table[static_cast<unsigned char>(c)];
     }
 
     constexpr static bool enabled = true;
@@ -89,6 +94,9 @@ struct trim_right : matcher<Cs...> {};
 template <char... Cs>
 struct escape : matcher<Cs...> {};
 
+template <char... Cs>
+struct comment : matcher<Cs...> {};
+
 template <typename T, template <char...> class Template>
 struct is_instance_of_matcher : std::false_type {};
 
@@ -161,12 +169,112 @@ struct get_multiline<> {
 template <typename... Ts>
 using get_multiline_t = typename get_multiline<Ts...>::type;
 
+////////////////
+// widths
+////////////////
+
+// widths of the columns of fixed width files
+template <size_t... Ws>
+struct widths {
+    constexpr static bool enabled = sizeof...(Ws) > 0;
+    constexpr static std::array<size_t, sizeof...(Ws)> values{Ws...};
+    // width of all the columns together
+    constexpr static size_t total = (Ws + ... + 0);
+};
+
+template <typename T>
+struct is_instance_of_widths : std::false_type {};
+
+template <size_t... Ws>
+struct is_instance_of_widths<widths<Ws...>> : std::true_type {};
+
+template <typename... Ts>
+struct get_widths;
+
+template <typename T, typename... Ts>
+struct get_widths<T, Ts...> {
+    using type = ternary_t<is_instance_of_widths<T>::value, T,
+                           typename get_widths<Ts...>::type>;
+};
+
+template <>
+struct get_widths<> {
+    using type = widths<>;
+};
+
+template <typename... Ts>
+using get_widths_t = typename get_widths<Ts...>::type;
+
+////////////////
+// character classes
+////////////////
+
+// bits of the character class table, every character is mapped to the
+// combination of matchers it belongs to so that the splitter can tell if a
+// character needs special handling with a single lookup
+namespace char_class {
+constexpr inline uint8_t none = 0;
+constexpr inline uint8_t quote = 1 << 0;
+constexpr inline uint8_t escape = 1 << 1;
+constexpr inline uint8_t trim_left = 1 << 2;
+constexpr inline uint8_t trim_right = 1 << 3;
+constexpr inline uint8_t terminator = 1 << 4;
+constexpr inline uint8_t delimiter = 1 << 5;
+} /* char_class */
+
+using char_class_table = std::array<uint8_t, 256>;
+
+template <typename Matcher>
+inline constexpr void add_char_class(char_class_table& table, uint8_t bit) {
+    if constexpr (Matcher::enabled) {
+        for (const auto& c : Matcher::matches) {
+            table[static_cast<unsigned char>(c)] |= bit;
+        }
+    }
+}
+
+template <typename Quote, typename Escape, typename TrimLeft,
+          typename TrimRight>
+inline constexpr char_class_table make_char_class_table() {
+    char_class_table table{};
+    table[0] = char_class::terminator;
+    add_char_class<Quote>(table, char_class::quote);
+    add_char_class<Escape>(table, char_class::escape);
+    add_char_class<TrimLeft>(table, char_class::trim_left);
+    add_char_class<TrimRight>(table, char_class::trim_right);
+    return table;
+}
+
 ////////////////
 // string_error
 ////////////////
 
 class string_error;
 
+////////////////
+// ignore_empty
+////////////////
+
+class ignore_empty;
+
+////////////////
+// quarantine
+////////////////
+
+class quarantine;
+
+////////////////
+// utf8
+////////////////
+
+class utf8;
+
+////////////////
+// follow
+////////////////
+
+class follow;
+
 ////////////////
 // setup implementation
 ////////////////
@@ -180,18 +288,38 @@ private:
                            is_instance_of_matcher_t<T, escape>,
                            is_instance_of_matcher_t<T, trim>,
                            is_instance_of_matcher_t<T, trim_left>,
-                           is_instance_of_matcher_t<T, trim_right>> {};
+                           is_instance_of_matcher_t<T, trim_right>,
+                           is_instance_of_matcher_t<T, comment>> {};
 
     template <typename T>
     struct is_string_error : std::is_same<T, string_error> {};
 
+    template <typename T>
+    struct is_ignore_empty : std::is_same<T, ignore_empty> {};
+
+    template <typename T>
+    struct is_quarantine : std::is_same<T, quarantine> {};
+
+    template <typename T>
+    struct is_utf8 : std::is_same<T, utf8> {};
+
+    template <typename T>
+    struct is_follow : std::is_same<T, follow> {};
+
     constexpr static auto count_matcher = count_v<is_matcher, Ts...>;
     constexpr static auto count_multiline =
         count_v<is_instance_of_multiline, Ts...>;
     constexpr static auto count_string_error = count_v<is_string_error, Ts...>;
+    constexpr static auto count_ignore_empty = count_v<is_ignore_empty, Ts...>;
+    constexpr static auto count_quarantine = count_v<is_quarantine, Ts...>;
+    constexpr static auto count_utf8 = count_v<is_utf8, Ts...>;
+    constexpr static auto count_widths = count_v<is_instance_of_widths, Ts...>;
+    constexpr static auto count_follow = count_v<is_follow, Ts...>;
 
     constexpr static auto number_of_valid_setup_types =
-        count_matcher + count_multiline + count_string_error;
+        count_matcher + count_multiline + count_string_error +
+        count_ignore_empty + count_quarantine + count_utf8 + count_widths +
+        count_follow;
 
     using trim_left_only = get_matcher_t<trim_left, Ts...>;
     using trim_right_only = get_matcher_t<trim_right, Ts...>;
@@ -200,12 +328,22 @@ private:
 public:
     using quote = get_matcher_t<quote, Ts...>;
     using escape = get_matcher_t<escape, Ts...>;
+    using comment = get_matcher_t<comment, Ts...>;
 
     using trim_left = ternary_t<trim_all::enabled, trim_all, trim_left_only>;
     using trim_right = ternary_t<trim_all::enabled, trim_all, trim_right_only>;
 
     using multiline = get_multiline_t<Ts...>;
+    using widths = get_widths_t<Ts...>;
     constexpr static bool string_error = (count_string_error == 1);
+    constexpr static bool ignore_empty = (count_ignore_empty == 1);
+    constexpr static bool quarantine = (count_quarantine == 1);
+    constexpr static bool utf8 = (count_utf8 == 1);
+    constexpr static bool follow = (count_follow == 1);
+
+    // the delimiter is not known at compile time, the splitter adds it
+    constexpr static char_class_table char_classes =
+        make_char_class_table<quote, escape, trim_left, trim_right>();
 
 private:
 #define ASSERT_MSG "cannot have the same match character in multiple matchers"
@@ -233,6 +371,15 @@ private:
     static_assert(count_multiline <= 1, "mutliline defined multiple times");
     static_assert(count_string_error <= 1,
                   "string_error defined multiple times");
+    static_assert(count_ignore_empty <= 1,
+                  "ignore_empty defined multiple times");
+    static_assert(count_quarantine <= 1, "quarantine defined multiple times");
+    static_assert(count_utf8 <= 1, "utf8 defined multiple times");
+    static_assert(count_widths <= 1, "widths defined multiple times");
+    static_assert(count_follow <= 1, "follow defined multiple times");
+
+    static_assert(!widths::enabled || (!quote::enabled && !escape::enabled),
+                  "quote and escape cannot be used with fixed widths");
 
     static_assert(number_of_valid_setup_types == sizeof...(Ts),
                   "one or multiple invalid setup parameters defined");
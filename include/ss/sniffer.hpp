@@ -0,0 +1,416 @@
+#pragma once
+#include "common.hpp"
+#include "setup.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// dialect
+////////////////
+
+// settings of a file guessed by the sniffer
+struct dialect {
+    // false if the file could not be read
+    bool valid{false};
+    std::string delimiter{default_delimiter};
+    // '\0' if disabled
+    char quote{'\0'};
+    char escape{'\0'};
+    // new lines were found within quoted or escaped columns
+    bool multiline{false};
+    bool crlf{false};
+    bool header{false};
+    size_t columns{0};
+
+    // invokes the function with the setup matching the dialect,
+    // eg. ss::setup<ss::quote<'"'>, ss::multiline>{}, all the setups the
+    // function can be invoked with are instantiated, so the function needs
+    // to return the same type for each of them
+    template <typename Fun>
+    decltype(auto) visit(Fun&& fun) const {
+        switch (quote) {
+        case '"':
+            return visit_escape<ss::quote<'"'>>(fun);
+        case '\'':
+            return visit_escape<ss::quote<'\''>>(fun);
+        default:
+            return visit_escape<>(fun);
+        }
+    }
+
+private:
+    template <typename... Ts, typename Fun>
+    decltype(auto) visit_escape(Fun& fun) const {
+        if (escape == '\\') {
+            return visit_multiline<Ts..., ss::escape<'\\'>>(fun);
+        }
+        return visit_multiline<Ts...>(fun);
+    }
+
+    template <typename... Ts, typename Fun>
+    decltype(auto) visit_multiline(Fun& fun) const {
+        if constexpr (sizeof...(Ts) > 0) {
+            if (multiline) {
+                return fun(setup<Ts..., ss::multiline>{});
+            }
+        }
+        return fun(setup<Ts...>{});
+    }
+};
+
+////////////////
+// sniffer
+////////////////
+
+// guesses the dialect of a file from a sample of its beginning, the
+// delimiter is the candidate found the same number of times within the most
+// rows, while quoting is enabled if it makes the rows more consistent or if
+// the quote character is found at the beginning of columns
+class sniffer {
+    constexpr static std::array<char, 5> delimiters{',', ';', '\t', '|', ':'};
+    constexpr static std::array<char, 2> quotes{'"', '\''};
+    constexpr static size_t header_rows = 32;
+
+    using delimiter_counts = std::array<size_t, delimiters.size()>;
+
+public:
+    explicit sniffer(size_t sample_size = 64 * 1024)
+        : sample_size_{sample_size == 0 ? 1 : sample_size} {
+    }
+
+    dialect sniff(const std::string& file_name) const {
+        dialect d;
+        std::string sample;
+        if (!read_sample(file_name, sample)) {
+            return d;
+        }
+        d.valid = true;
+
+        size_t eol = sample.find('\n');
+        d.crlf = eol != std::string::npos && eol > 0 && sample[eol - 1] == '\r';
+        d.escape = find_escape(sample);
+
+        candidate best = count(sample, '\0', d.escape);
+        for (char q : quotes) {
+            if (sample.find(q) == std::string::npos) {
+                continue;
+            }
+
+            candidate c = count(sample, q, d.escape);
+            if (c.consistency > best.consistency ||
+                (c.consistency == best.consistency &&
+                 encloses_columns(sample, q, c.delimiter))) {
+                best = c;
+            }
+        }
+
+        if (best.columns > 1) {
+            d.delimiter = std::string(1, best.delimiter);
+        }
+        d.quote = best.quote;
+        d.multiline = best.multiline;
+        d.columns = best.columns;
+        d.header = has_header(sample, d.delimiter[0], d.quote, d.escape);
+        return d;
+    }
+
+private:
+    struct candidate {
+        char delimiter{default_delimiter[0]};
+        char quote{'\0'};
+        double consistency{0};
+        size_t columns{1};
+        bool multiline{false};
+    };
+
+    ////////////////
+    // sample
+    ////////////////
+
+    bool read_sample(const std::string& file_name, std::string& sample) const {
+        FILE* file = fopen(file_name.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+
+        sample.resize(sample_size_);
+        sample.resize(fread(sample.data(), 1, sample.size(), file));
+        bool whole_file = feof(file);
+        fclose(file);
+
+        // the last row of the sample may be incomplete
+        if (!whole_file) {
+            if (size_t eol = sample.rfind('\n'); eol != std::string::npos) {
+                sample.resize(eol + 1);
+            }
+        }
+        return true;
+    }
+
+    static bool is_delimiter(char c) {
+        return std::find(delimiters.begin(), delimiters.end(), c) !=
+               delimiters.end();
+    }
+
+    static bool is_quote(char c) {
+        return std::find(quotes.begin(), quotes.end(), c) != quotes.end();
+    }
+
+    // '\\' is the escape character if it is used in front of a special
+    // character
+    static char find_escape(const std::string& sample) {
+        for (size_t i = sample.find('\\'); i != std::string::npos &&
+                                           i + 1 < sample.size();
+             i = sample.find('\\', i + 2)) {
+            char next = sample[i + 1];
+            if (next == '\\' || next == '\n' || is_delimiter(next) ||
+                is_quote(next)) {
+                return '\\';
+            }
+        }
+        return '\0';
+    }
+
+    ////////////////
+    // delimiter
+    ////////////////
+
+    // counts the delimiter candidates of every row in a single pass
+    candidate count(const std::string& sample, char quote, char escape) const {
+        constexpr auto index = [] {
+            std::array<int8_t, 256> index{};
+            for (auto& i : index) {
+                i = -1;
+            }
+            for (size_t i = 0; i < delimiters.size(); ++i) {
+                index[static_cast<unsigned char>(delimiters[i])] = i;
+            }
+            return index;
+        }();
+
+        candidate c;
+        c.quote = quote;
+
+        std::vector<delimiter_counts> rows;
+        delimiter_counts counts{};
+        bool quoted = false;
+        bool empty_row = true;
+        for (size_t i = 0; i < sample.size(); ++i) {
+            char ch = sample[i];
+            if (escape != '\0' && ch == escape) {
+                if (i + 1 < sample.size() && sample[i + 1] == '\n') {
+                    c.multiline = true;
+                }
+                ++i;
+                empty_row = false;
+                continue;
+            }
+
+            if (quote != '\0' && ch == quote) {
+                quoted = !quoted;
+            } else if (ch == '\n') {
+                if (quoted) {
+                    c.multiline = true;
+                    continue;
+                }
+                if (!empty_row) {
+                    rows.push_back(counts);
+                }
+                counts = {};
+                empty_row = true;
+                continue;
+            } else if (!quoted) {
+                if (auto k = index[static_cast<unsigned char>(ch)]; k >= 0) {
+                    ++counts[k];
+                }
+            }
+            if (ch != '\r') {
+                empty_row = false;
+            }
+        }
+        if (!empty_row) {
+            rows.push_back(counts);
+        }
+
+        if (rows.empty()) {
+            return c;
+        }
+
+        for (size_t k = 0; k < delimiters.size(); ++k) {
+            std::map<size_t, size_t> frequencies;
+            for (const auto& row : rows) {
+                ++frequencies[row[k]];
+            }
+
+            auto mode = std::max_element(frequencies.begin(),
+                                         frequencies.end(),
+                                         [](const auto& lhs, const auto& rhs) {
+                                             return lhs.second < rhs.second;
+                                         });
+            if (mode->first == 0) {
+                continue;
+            }
+
+            double consistency =
+                static_cast<double>(mode->second) / rows.size();
+            if (consistency > c.consistency ||
+                (consistency == c.consistency &&
+                 mode->first + 1 > c.columns)) {
+                c.delimiter = delimiters[k];
+                c.consistency = consistency;
+                c.columns = mode->first + 1;
+            }
+        }
+
+        // rows with one column are consistent as well
+        if (c.columns == 1) {
+            c.consistency = 1;
+        }
+        return c;
+    }
+
+    static bool encloses_columns(const std::string& sample, char quote,
+                                 char delimiter) {
+        for (size_t i = sample.find(quote); i != std::string::npos;
+             i = sample.find(quote, i + 1)) {
+            if (i == 0 || sample[i - 1] == delimiter ||
+                sample[i - 1] == '\n') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ////////////////
+    // header
+    ////////////////
+
+    static std::vector<std::vector<std::string_view>> split_rows(
+        const std::string& sample, char delimiter, char quote, char escape) {
+        std::vector<std::vector<std::string_view>> rows(1);
+        size_t begin = 0;
+        bool quoted = false;
+        for (size_t i = 0; i < sample.size() && rows.size() <= header_rows;
+             ++i) {
+            char ch = sample[i];
+            if (escape != '\0' && ch == escape) {
+                ++i;
+            } else if (quote != '\0' && ch == quote) {
+                quoted = !quoted;
+            } else if (!quoted && (ch == delimiter || ch == '\n')) {
+                rows.back().push_back(unquote(sample, begin, i, quote));
+                begin = i + 1;
+                if (ch == '\n') {
+                    rows.emplace_back();
+                }
+            }
+        }
+        if (begin < sample.size() && rows.size() <= header_rows) {
+            rows.back().push_back(
+                unquote(sample, begin, sample.size(), quote));
+        }
+        if (rows.back().empty()) {
+            rows.pop_back();
+        }
+        return rows;
+    }
+
+    static std::string_view unquote(const std::string& sample, size_t begin,
+                                    size_t end, char quote) {
+        std::string_view s{sample.data() + begin, end - begin};
+        while (!s.empty() && (s.back() == '\r' || s.back() == ' ')) {
+            s.remove_suffix(1);
+        }
+        while (!s.empty() && s.front() == ' ') {
+            s.remove_prefix(1);
+        }
+        if (quote != '\0' && s.size() >= 2 && s.front() == quote &&
+            s.back() == quote) {
+            s = s.substr(1, s.size() - 2);
+        }
+        return s;
+    }
+
+    static bool is_number(std::string_view s) {
+        size_t i = 0;
+        if (i < s.size() && (s[i] == '-' || s[i] == '+')) {
+            ++i;
+        }
+
+        size_t digits = 0;
+        bool dot = false;
+        for (; i < s.size(); ++i) {
+            if (s[i] >= '0' && s[i] <= '9') {
+                ++digits;
+            } else if (s[i] == '.' && !dot) {
+                dot = true;
+            } else {
+                break;
+            }
+        }
+        if (digits == 0) {
+            return false;
+        }
+
+        if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+            ++i;
+            if (i < s.size() && (s[i] == '-' || s[i] == '+')) {
+                ++i;
+            }
+            if (i == s.size()) {
+                return false;
+            }
+            while (i < s.size() && s[i] >= '0' && s[i] <= '9') {
+                ++i;
+            }
+        }
+        return i == s.size();
+    }
+
+    // the first row is a header if it is not numeric within columns which
+    // are numeric in all the other rows
+    static bool has_header(const std::string& sample, char delimiter,
+                           char quote, char escape) {
+        auto rows = split_rows(sample, delimiter, quote, escape);
+        if (rows.size() < 2) {
+            return false;
+        }
+
+        const auto& first = rows.front();
+        int votes = 0;
+        for (size_t column = 0; column < first.size(); ++column) {
+            bool numeric = true;
+            for (size_t i = 1; i < rows.size() && numeric; ++i) {
+                numeric = column < rows[i].size() &&
+                          is_number(rows[i][column]);
+            }
+
+            if (numeric) {
+                votes += is_number(first[column]) ? -1 : 1;
+            }
+        }
+        return votes > 0;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    size_t sample_size_;
+};
+
+// guesses the dialect of a file from its first 'sample_size' bytes
+inline dialect sniff(const std::string& file_name,
+                     size_t sample_size = 64 * 1024) {
+    return sniffer{sample_size}.sniff(file_name);
+}
+
+} /* ss */
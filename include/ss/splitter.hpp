@@ -19,6 +19,7 @@ private:
     using trim_right = typename setup<Ts...>::trim_right;
     using escape = typename setup<Ts...>::escape;
     using multiline = typename setup<Ts...>::multiline;
+    using widths = typename setup<Ts...>::widths;
 
     constexpr static auto string_error = setup<Ts...>::string_error;
     constexpr static auto is_const_line = !quote::enabled && !escape::enabled;
@@ -50,7 +51,11 @@ public:
         split_data_.clear();
         line_ = new_line;
         begin_ = line_;
-        return split_impl_select_delim(delimiter);
+        if constexpr (widths::enabled) {
+            return split_fixed();
+        } else {
+            return split_impl_select_delim(delimiter);
+        }
     }
 
 private:
@@ -188,7 +193,7 @@ private:
 
     void trim_left_if_enabled(line_ptr_type& curr) {
         if constexpr (trim_left::enabled) {
-            while (trim_left::match(*curr)) {
+            while (char_class_of(*curr) & char_class::trim_left) {
                 ++curr;
             }
         }
@@ -196,7 +201,7 @@ private:
 
     void trim_right_if_enabled(line_ptr_type& curr) {
         if constexpr (trim_right::enabled) {
-            while (trim_right::match(*curr)) {
+            while (char_class_of(*curr) & char_class::trim_right) {
                 ++curr;
             }
         }
@@ -206,9 +211,15 @@ private:
     std::tuple<size_t, bool> match_delimiter(line_ptr_type begin,
                                              const Delim& delim) {
         line_ptr_type end = begin;
-
         trim_right_if_enabled(end);
+        return match_delimiter(begin, end, delim);
+    }
 
+    // same as above, but with the end of the spacing already known
+    template <typename Delim>
+    std::tuple<size_t, bool> match_delimiter(line_ptr_type begin,
+                                             line_ptr_type end,
+                                             const Delim& delim) {
         // just spacing
         if (*end == '\0') {
             return {0, false};
@@ -262,6 +273,9 @@ private:
         split_data_.emplace_back(begin_, curr_);
     }
 
+    // moves the part of the column read since the last escape to the write
+    // position 'curr_', so every byte is moved at most once no matter how
+    // many escapes the column has
     void shift_and_set_current() {
         if constexpr (!is_const_line) {
             if (escaped_ > 0) {
@@ -273,6 +287,25 @@ private:
         curr_ = end_;
     }
 
+    ////////////////
+    // character classes
+    ////////////////
+
+    void set_delimiter_class(char c) {
+        if (c == delimiter_char_) {
+            return;
+        }
+        auto& old_class = char_classes_[static_cast<unsigned char>(
+            delimiter_char_)];
+        old_class &= ~char_class::delimiter;
+        char_classes_[static_cast<unsigned char>(c)] |= char_class::delimiter;
+        delimiter_char_ = c;
+    }
+
+    uint8_t char_class_of(char c) const {
+        return char_classes_[static_cast<unsigned char>(c)];
+    }
+
     ////////////////
     // split impl
     ////////////////
@@ -285,12 +318,49 @@ private:
             set_error_empty_delimiter();
             return split_data_;
         case 1:
+            set_delimiter_class(delimiter[0]);
             return split_impl(delimiter[0]);
         default:
+            set_delimiter_class(delimiter[0]);
             return split_impl(delimiter);
         }
     }
 
+    // the columns are found by their widths, the delimiter is not used,
+    // the characters after the last column are ignored, and the columns
+    // missing at the end of a shorter line are empty
+    const split_data& split_fixed() {
+        clear_error();
+        auto end = static_cast<const char*>(
+            std::memchr(line_, '\0', widths::total + 1));
+        if (end == nullptr) {
+            end = line_ + widths::total;
+        }
+
+        const char* begin = line_;
+        for (size_t width : widths::values) {
+            const char* column_end =
+                static_cast<size_t>(end - begin) < width ? end : begin + width;
+            const char* trimmed_begin = begin;
+            const char* trimmed_end = column_end;
+            if constexpr (trim_left::enabled) {
+                while (trimmed_begin != trimmed_end &&
+                       trim_left::match(*trimmed_begin)) {
+                    ++trimmed_begin;
+                }
+            }
+            if constexpr (trim_right::enabled) {
+                while (trimmed_end != trimmed_begin &&
+                       trim_right::match(*(trimmed_end - 1))) {
+                    --trimmed_end;
+                }
+            }
+            split_data_.emplace_back(trimmed_begin, trimmed_end);
+            begin = column_end;
+        }
+        return split_data_;
+    }
+
     template <typename Delim>
     const split_data& split_impl(const Delim& delim) {
 
@@ -331,7 +401,23 @@ private:
     template <typename Delim>
     void read_normal(const Delim& delim) {
         while (true) {
-            auto [width, valid] = match_delimiter(end_, delim);
+            // characters with no special meaning
+            while (char_class_of(*end_) == char_class::none) {
+                ++end_;
+            }
+
+            // the run of spacing is scanned only once, if it is followed by
+            // a character with no special meaning it is a part of the column
+            line_ptr_type spacing_end = end_;
+            trim_right_if_enabled(spacing_end);
+            if constexpr (trim_right::enabled) {
+                if (char_class_of(*spacing_end) == char_class::none) {
+                    end_ = spacing_end;
+                    continue;
+                }
+            }
+
+            auto [width, valid] = match_delimiter(end_, spacing_end, delim);
 
             if (!valid) {
                 // not a delimiter
@@ -355,7 +441,14 @@ private:
     template <typename Delim>
     void read_quoted(const Delim& delim) {
         if constexpr (quote::enabled) {
+            constexpr auto special = char_class::quote | char_class::escape |
+                                     char_class::terminator;
             while (true) {
+                // characters with no special meaning within quotes
+                while ((char_class_of(*end_) & special) == 0) {
+                    ++end_;
+                }
+
                 if (!quote::match(*end_)) {
                     if constexpr (escape::enabled) {
                         if (escape::match(*end_)) {
@@ -392,6 +485,15 @@ private:
                 // quote found
                 // ...
 
+                // double quote, checked first unless the quote character
+                // could also be the beginning of the delimiter
+                // eg: ...,"hel""lo",... -> hel"lo
+                if (char_class_of(end_[1]) == char_class::quote) {
+                    shift_and_jump_escape();
+                    ++end_;
+                    continue;
+                }
+
                 auto [width, valid] = match_delimiter(end_ + 1, delim);
 
                 // delimiter
@@ -439,6 +541,9 @@ public:
     size_t escaped_{0};
     split_data split_data_;
 
+    char_class_table char_classes_{setup<Ts...>::char_classes};
+    char delimiter_char_{'\0'};
+
     line_ptr_type begin_;
     line_ptr_type curr_;
     line_ptr_type end_;
@@ -448,4 +553,138 @@ public:
     friend class converter;
 };
 
+////////////////
+// record scanner
+////////////////
+
+// finds the end of a record which may span multiple lines without splitting
+// it, follows the same rules as the splitter for quoting, escaping, trimming
+// and delimiters, the scanner is fed one line at a time (without the new line
+// characters) and reports if the record ends with the given line
+template <typename... Ts>
+class record_scanner {
+    using quote = typename setup<Ts...>::quote;
+    using trim_left = typename setup<Ts...>::trim_left;
+    using trim_right = typename setup<Ts...>::trim_right;
+    using escape = typename setup<Ts...>::escape;
+
+    enum class state { field_start, unquoted, quoted };
+
+public:
+    record_scanner(const std::string& delimiter = default_delimiter)
+        : delimiter_{delimiter} {}
+
+    void reset() {
+        state_ = state::field_start;
+    }
+
+    // returns true if the record ends with the given line, returns false if
+    // the line ends within quotes or with an escaped new line
+    bool scan(const char* curr, const char* const end) {
+        while (curr != end) {
+            switch (state_) {
+            case state::field_start:
+                if constexpr (trim_left::enabled) {
+                    while (curr != end && trim_left::match(*curr)) {
+                        ++curr;
+                    }
+                    if (curr == end) {
+                        continue;
+                    }
+                }
+                if constexpr (quote::enabled) {
+                    if (quote::match(*curr)) {
+                        ++curr;
+                        state_ = state::quoted;
+                        continue;
+                    }
+                }
+                state_ = state::unquoted;
+                continue;
+
+            case state::unquoted:
+                if constexpr (escape::enabled) {
+                    if (escape::match(*curr)) {
+                        if (curr + 1 == end) {
+                            // escaped new line
+                            return false;
+                        }
+                        curr += 2;
+                        continue;
+                    }
+                }
+                if (match_delimiter(curr, end)) {
+                    curr += delimiter_.size();
+                    state_ = state::field_start;
+                    continue;
+                }
+                ++curr;
+                continue;
+
+            case state::quoted:
+                if constexpr (escape::enabled) {
+                    if (escape::match(*curr)) {
+                        if (curr + 1 == end) {
+                            return false;
+                        }
+                        curr += 2;
+                        continue;
+                    }
+                }
+                if constexpr (quote::enabled) {
+                    if (quote::match(*curr)) {
+                        ++curr;
+                        // double quote
+                        // eg: ...,"hel""lo",... -> hel"lo
+                        if (curr != end && quote::match(*curr)) {
+                            ++curr;
+                            continue;
+                        }
+
+                        if constexpr (trim_right::enabled) {
+                            while (curr != end && trim_right::match(*curr)) {
+                                ++curr;
+                            }
+                        }
+
+                        if (curr != end && match_delimiter(curr, end)) {
+                            curr += delimiter_.size();
+                            state_ = state::field_start;
+                            continue;
+                        }
+
+                        // either eol or mismatched quote, both end the record
+                        reset();
+                        return true;
+                    }
+                }
+                ++curr;
+                continue;
+            }
+        }
+
+        if (state_ == state::quoted) {
+            return false;
+        }
+        reset();
+        return true;
+    }
+
+private:
+    bool match_delimiter(const char* const curr, const char* const end) const {
+        if (delimiter_.size() == 1) {
+            return *curr == delimiter_[0];
+        }
+        return static_cast<size_t>(end - curr) >= delimiter_.size() &&
+               strncmp(curr, delimiter_.c_str(), delimiter_.size()) == 0;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string delimiter_;
+    state state_{state::field_start};
+};
+
 } /* ss */
@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// thread pool
+////////////////
+
+// work stealing thread pool, every worker has its own queue of tasks and
+// steals from the back of the other queues once its own is empty,
+// tasks are invoked with the index of the worker running them so that
+// per worker state can be kept outside of the pool
+class thread_pool {
+public:
+    using task = std::function<void(size_t)>;
+
+    explicit thread_pool(size_t size = std::thread::hardware_concurrency())
+        : queues_(size == 0 ? 1 : size) {
+        workers_.reserve(queues_.size());
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        has_tasks_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    thread_pool(const thread_pool& other) = delete;
+    thread_pool& operator=(const thread_pool& other) = delete;
+
+    size_t size() const {
+        return queues_.size();
+    }
+
+    void push(task t) {
+        size_t i = next_queue_++ % queues_.size();
+        push(i, std::move(t));
+    }
+
+    // pushes the task into the queue of the given worker
+    void push(size_t worker, task t) {
+        {
+            std::lock_guard lock{mutex_};
+            ++queued_;
+            ++unfinished_;
+        }
+        {
+            auto& q = queues_[worker % queues_.size()];
+            std::lock_guard lock{q.mutex};
+            q.tasks.push_back(std::move(t));
+        }
+        has_tasks_.notify_one();
+    }
+
+    // blocks until all pushed tasks are finished
+    void wait() {
+        std::unique_lock lock{mutex_};
+        all_done_.wait(lock, [this] { return unfinished_ == 0; });
+    }
+
+private:
+    struct queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    bool pop_own(size_t i, task& t) {
+        auto& q = queues_[i];
+        std::lock_guard lock{q.mutex};
+        if (q.tasks.empty()) {
+            return false;
+        }
+        t = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+
+    bool steal(size_t i, task& t) {
+        for (size_t j = 1; j < queues_.size(); ++j) {
+            auto& q = queues_[(i + j) % queues_.size()];
+            std::lock_guard lock{q.mutex};
+            if (!q.tasks.empty()) {
+                t = std::move(q.tasks.back());
+                q.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t i) {
+        task t;
+        while (true) {
+            if (pop_own(i, t) || steal(i, t)) {
+                {
+                    std::lock_guard lock{mutex_};
+                    --queued_;
+                }
+                t(i);
+                t = nullptr;
+
+                std::lock_guard lock{mutex_};
+                if (--unfinished_ == 0) {
+                    all_done_.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock{mutex_};
+            has_tasks_.wait(lock, [this] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) {
+                return;
+            }
+        }
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::vector<queue> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_queue_{0};
+
+    std::mutex mutex_;
+    std::condition_variable has_tasks_;
+    std::condition_variable all_done_;
+    size_t queued_{0};
+    size_t unfinished_{0};
+    bool stop_{false};
+};
+
+} /* ss */
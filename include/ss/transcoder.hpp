@@ -0,0 +1,327 @@
+#pragma once
+#include "common.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+
+namespace ss {
+
+////////////////
+// encoding
+////////////////
+
+// encoding of a file, utf-8 is assumed if it is detected and the file does
+// not start with a byte order mark
+enum class encoding { detect, utf8, utf16le, utf16be, latin1, windows1252 };
+
+// returns the encoding given by the byte order mark at the beginning of the
+// data and sets the size of the mark, or utf-8 if there is none
+inline encoding detect_encoding(const unsigned char* data, size_t size,
+                                size_t& bom_size) {
+    if (size >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF) {
+        bom_size = 3;
+        return encoding::utf8;
+    }
+    if (size >= 2 && data[0] == 0xFF && data[1] == 0xFE) {
+        bom_size = 2;
+        return encoding::utf16le;
+    }
+    if (size >= 2 && data[0] == 0xFE && data[1] == 0xFF) {
+        bom_size = 2;
+        return encoding::utf16be;
+    }
+    bom_size = 0;
+    return encoding::utf8;
+}
+
+////////////////
+// transcoder
+////////////////
+
+// reads lines of a file in the given encoding and converts them to utf-8,
+// the file is read and converted in blocks, runs of ascii characters are
+// converted eight bytes at a time, the number of bytes each line takes
+// within the file is kept so that positions within the file stay correct
+class transcoder {
+    constexpr static size_t block_size = 64 * 1024;
+    constexpr static uint32_t replacement = 0xFFFD;
+
+public:
+    transcoder() = default;
+
+    explicit transcoder(ss::encoding encoding) : encoding_{encoding} {}
+
+    // false if the file is already utf-8
+    bool enabled() const {
+        return encoding_ != encoding::detect && encoding_ != encoding::utf8;
+    }
+
+    // needs to be called after seeking within the file
+    void reset() {
+        buffer_.clear();
+        begin_ = 0;
+        pending_.clear();
+        line_sizes_.clear();
+        source_size_ = 0;
+        eof_ = false;
+    }
+
+    // same as get_line, but the line is converted to utf-8, 'size' is set
+    // to the number of bytes the line takes within the file
+    ssize_t get_line(char** lineptr, size_t* n, FILE* file, size_t& size) {
+        size_t search_begin = begin_;
+        size_t eol;
+        while ((eol = buffer_.find('\n', search_begin)) == std::string::npos) {
+            if (eof_) {
+                break;
+            }
+            search_begin = buffer_.size() - begin_;
+            read_block(file);
+            search_begin += begin_;
+        }
+
+        size_t end;
+        if (eol != std::string::npos) {
+            end = eol + 1;
+            size = line_sizes_.front();
+            line_sizes_.pop_front();
+        } else {
+            if (begin_ == buffer_.size()) {
+                return -1;
+            }
+            end = buffer_.size();
+            size = source_size_;
+            source_size_ = 0;
+        }
+
+        size_t line_size = end - begin_;
+        if (*lineptr == nullptr || *n < line_size + 1) {
+            *n = std::max<size_t>(128, 2 * (line_size + 1));
+            *lineptr = static_cast<char*>(realloc(*lineptr, *n));
+        }
+        std::memcpy(*lineptr, buffer_.data() + begin_, line_size);
+        (*lineptr)[line_size] = '\0';
+        begin_ = end;
+        return line_size;
+    }
+
+private:
+    ////////////////
+    // reading
+    ////////////////
+
+    void read_block(FILE* file) {
+        // the lines already returned are dropped
+        buffer_.erase(0, begin_);
+        begin_ = 0;
+
+        std::string block = std::move(pending_);
+        pending_.clear();
+        size_t size = block.size();
+        block.resize(size + block_size);
+        block.resize(size + fread(block.data() + size, 1, block_size, file));
+        eof_ = block.size() == size;
+
+        auto data = reinterpret_cast<const unsigned char*>(block.data());
+        size_t used;
+        switch (encoding_) {
+        case encoding::utf16le:
+            used = convert_utf16<false>(data, block.size());
+            break;
+        case encoding::utf16be:
+            used = convert_utf16<true>(data, block.size());
+            break;
+        default:
+            used = convert_single_byte(data, block.size());
+            break;
+        }
+        pending_.assign(block, used, std::string::npos);
+
+        if (eof_ && !pending_.empty()) {
+            // truncated code unit or unpaired surrogate at the end
+            source_size_ += pending_.size();
+            pending_.clear();
+            append(replacement);
+        }
+    }
+
+    ////////////////
+    // conversion
+    ////////////////
+
+    void append(uint32_t code_point) {
+        if (code_point < 0x80) {
+            buffer_.push_back(static_cast<char>(code_point));
+        } else if (code_point < 0x800) {
+            buffer_.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            buffer_.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else if (code_point < 0x10000) {
+            buffer_.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            buffer_.push_back(
+                static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            buffer_.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else {
+            buffer_.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            buffer_.push_back(
+                static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            buffer_.push_back(
+                static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            buffer_.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+    }
+
+    // the number of bytes the line takes within the file is stored for
+    // every new line
+    void add_source_bytes(size_t size, bool new_line) {
+        source_size_ += size;
+        if (new_line) {
+            line_sizes_.push_back(source_size_);
+            source_size_ = 0;
+        }
+    }
+
+    // true if one of the lanes (bytes or pairs of bytes) of the word is zero
+    template <uint64_t Ones, uint64_t Highs>
+    static bool has_zero_lane(uint64_t x) {
+        return ((x - Ones) & ~x & Highs) != 0;
+    }
+
+    size_t convert_single_byte(const unsigned char* data, size_t size) {
+        constexpr uint64_t ones = 0x0101010101010101ULL;
+        constexpr uint64_t highs = 0x8080808080808080ULL;
+        constexpr uint64_t new_lines = 0x0A0A0A0A0A0A0A0AULL;
+
+        size_t i = 0;
+        while (i < size) {
+            if (size - i >= 8) {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                if ((word & highs) == 0 &&
+                    !has_zero_lane<ones, highs>(word ^ new_lines)) {
+                    buffer_.append(reinterpret_cast<const char*>(data + i), 8);
+                    add_source_bytes(8, false);
+                    i += 8;
+                    continue;
+                }
+            }
+
+            unsigned char c = data[i++];
+            if (c < 0x80) {
+                buffer_.push_back(static_cast<char>(c));
+            } else if (encoding_ == encoding::windows1252 && c < 0xA0) {
+                append(windows1252_code_point(c));
+            } else {
+                append(c);
+            }
+            add_source_bytes(1, c == '\n');
+        }
+        return size;
+    }
+
+    // characters of windows-1252 which differ from latin-1, the undefined
+    // ones are kept as latin-1 control characters
+    static uint32_t windows1252_code_point(unsigned char c) {
+        constexpr uint16_t table[32] = {
+            0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+            0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+            0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+            0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178};
+        return table[c - 0x80];
+    }
+
+    template <bool BigEndian>
+    static uint32_t unit(const unsigned char* data) {
+        if constexpr (BigEndian) {
+            return (data[0] << 8) | data[1];
+        } else {
+            return data[0] | (data[1] << 8);
+        }
+    }
+
+    // returns the number of bytes converted, an incomplete code unit or
+    // surrogate pair at the end is left for the next block
+    template <bool BigEndian>
+    size_t convert_utf16(const unsigned char* data, size_t size) {
+        // the units as loaded on a little endian machine, the ascii units
+        // are converted four at a time only on such machines
+        constexpr uint64_t ones = 0x0001000100010001ULL;
+        constexpr uint64_t highs = 0x8000800080008000ULL;
+        constexpr uint64_t non_ascii = BigEndian ? 0x80FF80FF80FF80FFULL
+                                                 : 0xFF80FF80FF80FF80ULL;
+        constexpr uint64_t new_lines = BigEndian ? 0x0A000A000A000A00ULL
+                                                 : 0x000A000A000A000AULL;
+        const bool little_endian_machine = is_little_endian();
+
+        size_t i = 0;
+        while (size - i >= 2) {
+            if (little_endian_machine && size - i >= 8) {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                if ((word & non_ascii) == 0 &&
+                    !has_zero_lane<ones, highs>(word ^ new_lines)) {
+                    for (size_t j = BigEndian ? 1 : 0; j < 8; j += 2) {
+                        buffer_.push_back(static_cast<char>(data[i + j]));
+                    }
+                    add_source_bytes(8, false);
+                    i += 8;
+                    continue;
+                }
+            }
+
+            uint32_t u = unit<BigEndian>(data + i);
+            if (u >= 0xD800 && u < 0xDC00) {
+                if (size - i < 4) {
+                    // the low surrogate may be in the next block
+                    break;
+                }
+                uint32_t low = unit<BigEndian>(data + i + 2);
+                if (low >= 0xDC00 && low < 0xE000) {
+                    append(0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00));
+                    add_source_bytes(4, false);
+                    i += 4;
+                    continue;
+                }
+                u = replacement;
+            } else if (u >= 0xDC00 && u < 0xE000) {
+                u = replacement;
+            }
+
+            append(u);
+            add_source_bytes(2, u == '\n');
+            i += 2;
+        }
+        return i;
+    }
+
+    static bool is_little_endian() {
+        uint16_t x = 1;
+        unsigned char first;
+        std::memcpy(&first, &x, 1);
+        return first == 1;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    ss::encoding encoding_{encoding::utf8};
+
+    // converted data, the lines before 'begin_' are already returned
+    std::string buffer_;
+    size_t begin_{0};
+
+    // bytes of the file which could not be converted yet
+    std::string pending_;
+
+    // bytes of the file taken by each converted line which is not returned
+    // yet, and by the converted data after the last new line
+    std::deque<size_t> line_sizes_;
+    size_t source_size_{0};
+    bool eof_{false};
+};
+
+} /* ss */
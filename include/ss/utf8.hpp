@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace ss {
+
+////////////////
+// utf8 validation
+////////////////
+
+// returns the size of the valid sequence at the beginning of the data, or 0
+// if the sequence is not valid, overlong encodings, surrogates and code
+// points above U+10FFFF are not valid
+inline size_t utf8_sequence_size(const unsigned char* begin,
+                                 const unsigned char* end) {
+    unsigned char c = begin[0];
+    size_t size;
+    // bounds of the second byte, the other bytes are 0x80 - 0xBF
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+
+    if (c < 0xC2) {
+        return 0;
+    } else if (c < 0xE0) {
+        size = 2;
+    } else if (c < 0xF0) {
+        size = 3;
+        if (c == 0xE0) {
+            low = 0xA0;
+        } else if (c == 0xED) {
+            high = 0x9F;
+        }
+    } else if (c < 0xF5) {
+        size = 4;
+        if (c == 0xF0) {
+            low = 0x90;
+        } else if (c == 0xF4) {
+            high = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+
+    if (static_cast<size_t>(end - begin) < size || begin[1] < low ||
+        begin[1] > high) {
+        return 0;
+    }
+    for (size_t i = 2; i < size; ++i) {
+        if ((begin[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return size;
+}
+
+// returns the position of the first invalid byte, or the size of the data
+// if it is valid, ascii is skipped eight bytes at a time
+inline size_t find_invalid_utf8(const char* data, size_t size) {
+    constexpr uint64_t high_bits = 0x8080808080808080ULL;
+
+    auto begin = reinterpret_cast<const unsigned char*>(data);
+    auto end = begin + size;
+    auto curr = begin;
+    while (curr != end) {
+        if (end - curr >= 8) {
+            uint64_t word;
+            std::memcpy(&word, curr, sizeof(word));
+            if ((word & high_bits) == 0) {
+                curr += 8;
+                continue;
+            }
+        }
+
+        if (*curr < 0x80) {
+            ++curr;
+            continue;
+        }
+
+        size_t sequence_size = utf8_sequence_size(curr, end);
+        if (sequence_size == 0) {
+            break;
+        }
+        curr += sequence_size;
+    }
+    return curr - begin;
+}
+
+} /* ss */
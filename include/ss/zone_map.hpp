@@ -0,0 +1,210 @@
+#pragma once
+#include "common.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ss {
+
+////////////////
+// zone map
+////////////////
+
+constexpr inline size_t default_zone_rows = 64 * 1024;
+
+// statistics of one column for every zone (chunk of rows) of a file, the
+// zones which cannot contain values within a range can then be skipped by
+// restricting the parser to the ranges of the other zones, the map is
+// built by the parser using build_zone_map, or filled by the caller
+template <typename T>
+class zone_map {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "zone map values need to be trivially copyable");
+
+    constexpr static char magic[4] = {'s', 's', 'z', 'm'};
+    constexpr static uint32_t version = 2;
+
+public:
+    struct zone {
+        ss::position begin;
+        size_t rows{0};
+        // rows whose column could not be converted
+        size_t nulls{0};
+        T min{};
+        T max{};
+    };
+
+    explicit zone_map(size_t zone_rows = default_zone_rows)
+        : zone_rows_{zone_rows == 0 ? 1 : zone_rows} {
+    }
+
+    // adds the row at the given position with its converted column
+    void add(const ss::position& position, const T& value) {
+        zone& z = next_zone(position);
+        if (z.rows == z.nulls) {
+            z.min = z.max = value;
+        } else {
+            z.min = std::min(z.min, value);
+            z.max = std::max(z.max, value);
+        }
+        ++z.rows;
+    }
+
+    // adds the row at the given position whose column is not valid
+    void add_null(const ss::position& position) {
+        zone& z = next_zone(position);
+        ++z.rows;
+        ++z.nulls;
+    }
+
+    const std::vector<zone>& zones() const {
+        return zones_;
+    }
+
+    size_t zone_rows() const {
+        return zone_rows_;
+    }
+
+    void clear() {
+        zones_.clear();
+    }
+
+    // ranges of the zones which may contain values within [min, max],
+    // neighbouring zones are merged into one range
+    std::vector<ss::row_range> ranges(const T& min, const T& max) const {
+        std::vector<ss::row_range> ranges;
+        bool previous_matched = false;
+        for (const auto& z : zones_) {
+            if (z.rows == z.nulls || z.max < min || max < z.min) {
+                previous_matched = false;
+                continue;
+            }
+
+            if (previous_matched) {
+                ranges.back().rows += z.rows;
+            } else {
+                ranges.push_back({z.begin, z.rows});
+            }
+            previous_matched = true;
+        }
+        return ranges;
+    }
+
+    ////////////////
+    // sidecar
+    ////////////////
+
+    // stores the zones of the source file into the given file, the file is
+    // only meant to be read on the machine it was written on
+    bool save(const std::string& file_name,
+              const std::string& source_file_name) const {
+        header h{{}, version, sizeof(T), zone_rows_, zones_.size(), 0, 0};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        if (!source_stamp(source_file_name, h.source_size, h.source_time)) {
+            return false;
+        }
+
+        FILE* file = fopen(file_name.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+
+        bool ok = fwrite(&h, sizeof(h), 1, file) == 1 &&
+                  fwrite(zones_.data(), sizeof(zone), zones_.size(), file) ==
+                      zones_.size();
+        return (fclose(file) == 0) && ok;
+    }
+
+    // loads the zones stored by save, the file is ignored if the size or
+    // the modification time of the source file changed since
+    bool load(const std::string& file_name,
+              const std::string& source_file_name) {
+        uint64_t source_size;
+        int64_t source_time;
+        if (!source_stamp(source_file_name, source_size, source_time)) {
+            return false;
+        }
+
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(file_name, ec);
+        if (ec) {
+            return false;
+        }
+
+        FILE* file = fopen(file_name.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+
+        header h;
+        bool ok = fread(&h, sizeof(h), 1, file) == 1 &&
+                  std::memcmp(h.magic, magic, sizeof(magic)) == 0 &&
+                  h.version == version && h.value_size == sizeof(T) &&
+                  h.source_size == source_size &&
+                  h.source_time == source_time &&
+                  // checked before the zones are allocated
+                  (file_size - sizeof(h)) % sizeof(zone) == 0 &&
+                  h.zones == (file_size - sizeof(h)) / sizeof(zone);
+        if (ok) {
+            std::vector<zone> zones(h.zones);
+            ok = fread(zones.data(), sizeof(zone), zones.size(), file) ==
+                 zones.size();
+            if (ok) {
+                zones_ = std::move(zones);
+                zone_rows_ = h.zone_rows;
+            }
+        }
+        fclose(file);
+        return ok;
+    }
+
+private:
+    struct header {
+        char magic[4];
+        uint32_t version;
+        uint64_t value_size;
+        uint64_t zone_rows;
+        uint64_t zones;
+        // identify the source file the zones were built from
+        uint64_t source_size;
+        int64_t source_time;
+    };
+
+    static bool source_stamp(const std::string& source_file_name,
+                             uint64_t& size, int64_t& time) {
+        std::error_code ec;
+        size = std::filesystem::file_size(source_file_name, ec);
+        if (ec) {
+            return false;
+        }
+        auto write_time =
+            std::filesystem::last_write_time(source_file_name, ec);
+        if (ec) {
+            return false;
+        }
+        time = write_time.time_since_epoch().count();
+        return true;
+    }
+
+    zone& next_zone(const ss::position& position) {
+        if (zones_.empty() || zones_.back().rows == zone_rows_) {
+            zones_.push_back({position, 0, 0, T{}, T{}});
+        }
+        return zones_.back();
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    size_t zone_rows_;
+    std::vector<zone> zones_;
+};
+
+} /* ss */
@@ -0,0 +1,111 @@
+#include "test_helpers.hpp"
+#include <cstring>
+#include <fstream>
+#include <ss/arrow.hpp>
+
+namespace {
+bool is_valid(const ArrowArray& array, size_t i) {
+    auto validity = static_cast<const uint8_t*>(array.buffers[0]);
+    return !validity || (validity[i / 8] >> (i % 8)) & 1;
+}
+} /* namespace */
+
+TEST_CASE("arrow test export") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,x,1.5,true\n"
+            << "junk,yy,,false\n"
+            << "3,too,many,columns,here\n"
+            << "4,,2.5,junk\n";
+    }
+
+    ss::parser p{f.name, ","};
+    ss::arrow_builder<int32_t, std::string, double, bool> builder{
+        {"a", "b", "c"}};
+    CHECK_EQ(builder.read(p), 1);
+    CHECK_EQ(builder.size(), 3);
+
+    ArrowArray array;
+    ArrowSchema schema;
+    builder.export_to(&array, &schema);
+    CHECK_EQ(builder.size(), 0);
+
+    CHECK_EQ(std::string{schema.format}, "+s");
+    REQUIRE_EQ(schema.n_children, 4);
+    CHECK_EQ(std::string{schema.children[0]->format}, "i");
+    CHECK_EQ(std::string{schema.children[1]->format}, "u");
+    CHECK_EQ(std::string{schema.children[2]->format}, "g");
+    CHECK_EQ(std::string{schema.children[3]->format}, "b");
+    CHECK_EQ(std::string{schema.children[0]->name}, "a");
+    CHECK_EQ(std::string{schema.children[2]->name}, "c");
+    CHECK_EQ(std::string{schema.children[3]->name}, "3");
+
+    CHECK_EQ(array.length, 3);
+    REQUIRE_EQ(array.n_children, 4);
+
+    const ArrowArray& ints = *array.children[0];
+    CHECK_EQ(ints.null_count, 1);
+    CHECK(is_valid(ints, 0));
+    CHECK_FALSE(is_valid(ints, 1));
+    CHECK(is_valid(ints, 2));
+    auto int_values = static_cast<const int32_t*>(ints.buffers[1]);
+    CHECK_EQ(int_values[0], 1);
+    CHECK_EQ(int_values[2], 4);
+
+    const ArrowArray& strings = *array.children[1];
+    CHECK_EQ(strings.n_buffers, 3);
+    CHECK_EQ(strings.null_count, 0);
+    CHECK_EQ(strings.buffers[0], nullptr);
+    auto offsets = static_cast<const int32_t*>(strings.buffers[1]);
+    auto data = static_cast<const char*>(strings.buffers[2]);
+    CHECK_EQ(std::string(data + offsets[0], offsets[1] - offsets[0]), "x");
+    CHECK_EQ(std::string(data + offsets[1], offsets[2] - offsets[1]), "yy");
+    CHECK_EQ(offsets[3], offsets[2]);
+
+    const ArrowArray& doubles = *array.children[2];
+    CHECK_EQ(doubles.null_count, 1);
+    CHECK_FALSE(is_valid(doubles, 1));
+    CHECK_EQ(static_cast<const double*>(doubles.buffers[1])[2], 2.5);
+
+    const ArrowArray& bools = *array.children[3];
+    CHECK_EQ(bools.null_count, 1);
+    auto bits = static_cast<const uint8_t*>(bools.buffers[1]);
+    CHECK_EQ(bits[0] & 1, 1);
+    CHECK_EQ(bits[0] & 2, 0);
+    CHECK_FALSE(is_valid(bools, 2));
+
+    // the structures may be released in any order
+    array.release(&array);
+    CHECK_EQ(array.release, nullptr);
+    schema.release(&schema);
+    CHECK_EQ(schema.release, nullptr);
+}
+
+TEST_CASE("arrow test append") {
+    ss::arrow_builder<uint8_t> builder;
+    for (int i = 0; i < 20; ++i) {
+        builder.append(i % 7 == 0 ? std::nullopt
+                                  : std::optional<uint8_t>(i));
+    }
+
+    ArrowArray array;
+    ArrowSchema schema;
+    builder.export_to(&array, &schema);
+    schema.release(&schema);
+
+    // children can be moved out of their parents
+    ArrowArray child = *array.children[0];
+    array.children[0]->release = nullptr;
+    array.release(&array);
+
+    CHECK_EQ(child.length, 20);
+    CHECK_EQ(child.null_count, 3);
+    for (size_t i = 0; i < 20; ++i) {
+        CHECK_EQ(is_valid(child, i), i % 7 != 0);
+        if (i % 7 != 0) {
+            CHECK_EQ(static_cast<const uint8_t*>(child.buffers[1])[i], i);
+        }
+    }
+    child.release(&child);
+}
@@ -0,0 +1,136 @@
+#include "test_helpers.hpp"
+#include <filesystem>
+#include <fstream>
+#include <ss/cached_parser.hpp>
+
+namespace {
+struct Z {
+    int i;
+    double d;
+    std::string s;
+
+    auto tied() const {
+        return std::tie(i, d, s);
+    }
+
+    bool operator==(const Z& other) const {
+        return tied() == other.tied();
+    }
+};
+} /* namespace */
+
+TEST_CASE("cached parser test cache") {
+    unique_file_name f;
+    std::vector<Z> data;
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 100; ++i) {
+            data.push_back({i, i / 4.0, "\"x\"" + std::string(i, 'y')});
+            out << i << ',' << i / 4.0 << ",\"\"\"x\"\"" << std::string(i, 'y')
+                << '"' << std::endl;
+        }
+    }
+
+    ss::cached_parser<ss::quote<'"'>> p{f.name, ","};
+    auto read = [&] {
+        std::vector<Z> values;
+        p.for_each<int, double, std::string>(
+            [&](int i, double d, std::string s) {
+                values.push_back({i, d, std::move(s)});
+            });
+        CHECK(p.valid());
+        return values;
+    };
+
+    CHECK_EQ(read(), data);
+    CHECK_FALSE(p.cached());
+    REQUIRE(std::filesystem::exists(p.cache_file_name()));
+
+    CHECK_EQ(read(), data);
+    CHECK(p.cached());
+
+    // different types are not read from the same cache
+    std::vector<std::tuple<int, double>> values;
+    p.for_each<int, double, void>(
+        [&](std::tuple<int, double> t) { values.push_back(t); });
+    CHECK_FALSE(p.cached());
+    CHECK_EQ(values.size(), 100);
+    CHECK_EQ(values[10], std::tuple{10, 2.5});
+
+    // a changed file is parsed again
+    {
+        std::ofstream out{f.name, std::ios::app};
+        out << "100,25,z" << std::endl;
+    }
+    data.push_back({100, 25, "z"});
+    CHECK_EQ(read(), data);
+    CHECK_FALSE(p.cached());
+    CHECK_EQ(read(), data);
+    CHECK(p.cached());
+
+    std::filesystem::remove(p.cache_file_name());
+}
+
+TEST_CASE("cached parser test corrupt cache") {
+    unique_file_name f;
+    std::vector<std::tuple<int, std::string>> data;
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 10; ++i) {
+            data.emplace_back(i, std::string(i, 'x'));
+            out << i << ',' << std::string(i, 'x') << std::endl;
+        }
+    }
+
+    ss::cached_parser p{f.name, ","};
+    auto read = [&] {
+        std::vector<std::tuple<int, std::string>> values;
+        p.for_each<int, std::string>(
+            [&](std::tuple<int, std::string> t) { values.push_back(t); });
+        CHECK(p.valid());
+        return values;
+    };
+
+    CHECK_EQ(read(), data);
+    CHECK_EQ(read(), data);
+    REQUIRE(p.cached());
+
+    // truncated cache
+    auto size = std::filesystem::file_size(p.cache_file_name());
+    std::filesystem::resize_file(p.cache_file_name(), size - 5);
+    CHECK_EQ(read(), data);
+    CHECK_FALSE(p.cached());
+    CHECK_EQ(read(), data);
+    REQUIRE(p.cached());
+
+    // number of rows which do not fit into the cache
+    {
+        std::fstream out{p.cache_file_name(),
+                         std::ios::binary | std::ios::in | std::ios::out};
+        out.seekp(24);
+        out << std::string(8, '\xff');
+    }
+    CHECK_EQ(read(), data);
+    CHECK_FALSE(p.cached());
+
+    std::filesystem::remove(p.cache_file_name());
+}
+
+TEST_CASE("cached parser test invalid rows") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,x" << std::endl;
+        out << "y,2" << std::endl;
+    }
+
+    ss::cached_parser<ss::string_error> p{f.name, ",", f.name + ".cache"};
+    CHECK_EQ(p.cache_file_name(), f.name + ".cache");
+
+    size_t rows = 0;
+    p.for_each<int, std::string>([&] { ++rows; });
+    CHECK_EQ(rows, 1);
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("'y'"), std::string::npos);
+    CHECK_FALSE(std::filesystem::exists(p.cache_file_name()));
+}
@@ -242,6 +242,81 @@ TEST_CASE("converter test ss:ir restriction (in range)") {
     }
 }
 
+TEST_CASE("converter test restrictions with integer bounds") {
+    ss::converter<ss::string_error> c;
+    auto is_validation_error = [&c] {
+        return c.error_msg().find("validation error") != std::string::npos;
+    };
+    auto is_conversion_error = [&c] {
+        return c.error_msg().find("invalid conversion") != std::string::npos;
+    };
+
+    CHECK_EQ(c.convert<ss::ir<int, 0, 999>>("0042"), 42);
+    REQUIRE(c.valid());
+    CHECK_EQ(c.convert<ss::ir<int, -5, 999>>("-5"), -5);
+    REQUIRE(c.valid());
+    CHECK_EQ(c.convert<ss::ir<int, 0, 999>>("-0"), 0);
+    REQUIRE(c.valid());
+    CHECK_EQ(c.convert<ss::ir<int, -100, 100>>("007"), 7);
+    REQUIRE(c.valid());
+
+    // a sign without digits
+    c.convert<ss::ir<int, -100, 100>>("-");
+    CHECK(is_conversion_error());
+    c.convert<ss::gte<int, 0>>("-");
+    CHECK(is_conversion_error());
+    c.convert<ss::lt<int, 10>>("-");
+    CHECK(is_conversion_error());
+    c.convert<ss::ir<unsigned, 0, 100>>("-");
+    CHECK(is_conversion_error());
+
+    // rejected by the number of digits
+    c.convert<ss::ir<int, 0, 999>>("1000");
+    CHECK(is_validation_error());
+    c.convert<ss::ir<int, 0, 999>>("99999999999999999999");
+    CHECK(is_validation_error());
+    c.convert<ss::ir<int, 0, 999>>("-1");
+    CHECK(is_validation_error());
+    c.convert<ss::ir<int, 0, 999>>("1000x");
+    CHECK(is_conversion_error());
+    c.convert<ss::ir<int, 0, 999>>("1x");
+    CHECK(is_conversion_error());
+    c.convert<ss::ir<int, 0, 999>>("x");
+    CHECK(is_conversion_error());
+
+    // exclusive bounds
+    CHECK_EQ(c.convert<ss::gt<int, 9>>("10"), 10);
+    REQUIRE(c.valid());
+    c.convert<ss::gt<int, 9>>("9");
+    CHECK(is_validation_error());
+    CHECK_EQ(c.convert<ss::lt<int, 10>>("-2147483648"),
+             std::numeric_limits<int>::min());
+    REQUIRE(c.valid());
+    c.convert<ss::lt<int, 10>>("10");
+    CHECK(is_validation_error());
+    CHECK_EQ(c.convert<ss::gte<unsigned, 3>>("4294967295"),
+             std::numeric_limits<unsigned>::max());
+    REQUIRE(c.valid());
+    c.convert<ss::gte<unsigned, 3>>("4294967296");
+    CHECK(is_validation_error());
+    c.convert<ss::lte<unsigned, 3>>("-1");
+    CHECK(is_conversion_error());
+    CHECK_EQ(c.convert<ss::ir<int8_t, -128, 0>>("-128"), -128);
+    REQUIRE(c.valid());
+    c.convert<ss::ir<int8_t, -128, 0>>("-129");
+    CHECK(is_validation_error());
+
+    // bounds which cannot be used while converting
+    CHECK_EQ(c.convert<ss::gt<int, 2L>>("3"), 3);
+    REQUIRE(c.valid());
+    c.convert<ss::gt<int, std::numeric_limits<int>::max()>>("3");
+    CHECK(is_validation_error());
+    c.convert<ss::ir<short, 0, 100000>>("5");
+    REQUIRE(c.valid());
+    CHECK_EQ(c.convert<ss::ir<double, 0, 9>>("2.5"), 2.5);
+    REQUIRE(c.valid());
+}
+
 TEST_CASE("converter test ss:oor restriction (out of range)") {
     ss::converter c;
 
@@ -487,3 +562,165 @@ TEST_CASE("converter test invalid split conversions") {
         CHECK_FALSE(c.error_msg().empty());
     }
 }
+
+TEST_CASE("converter test dict_string") {
+    ss::converter c;
+
+    auto [a, i, b] = c.convert<ss::dict_string, int, ss::dict_string>("x,1,y");
+    REQUIRE(c.valid());
+    CHECK_EQ(a.value, "x");
+    CHECK_EQ(b.value, "y");
+    CHECK_EQ(i, 1);
+    CHECK_NE(a.id, b.id);
+
+    auto [a2, b2] = c.convert<ss::dict_string, ss::dict_string>("y,x");
+    REQUIRE(c.valid());
+    CHECK_EQ(a2.id, b.id);
+    CHECK_EQ(b2.id, a.id);
+    CHECK_EQ(a2.value.data(), b.value.data());
+    CHECK_EQ(b2.value.data(), a.value.data());
+    CHECK_EQ(c.dictionary().size(), 2);
+    CHECK_EQ(c.dictionary()[a.id], "x");
+
+    std::string_view view = c.convert<ss::dict_string>("x");
+    REQUIRE(c.valid());
+    CHECK_EQ(view.data(), a.value.data());
+}
+
+TEST_CASE("converter test arena_string") {
+    ss::converter c;
+
+    auto [a, i, b] =
+        c.convert<ss::arena_string, int, ss::arena_string>("xx,1,yyy");
+    REQUIRE(c.valid());
+    CHECK_EQ(a.value, "xx");
+    CHECK_EQ(b.value, "yyy");
+    CHECK_EQ(i, 1);
+    // stored one after another
+    CHECK_EQ(a.value.data() + a.value.size(), b.value.data());
+    CHECK_EQ(c.arena().size(), 5);
+
+    c.arena().clear();
+    CHECK_EQ(c.arena().size(), 0);
+
+    std::string_view view = c.convert<ss::arena_string>("zz");
+    REQUIRE(c.valid());
+    CHECK_EQ(view, "zz");
+    CHECK_EQ(view.data(), a.value.data());
+}
+
+TEST_CASE("converter test arena blocks") {
+    ss::arena arena{4};
+    std::string s = "0123456789";
+
+    std::vector<std::string_view> values;
+    for (size_t i = 0; i <= s.size(); ++i) {
+        values.push_back(arena.store(s.data(), s.data() + i));
+    }
+
+    for (size_t i = 0; i <= s.size(); ++i) {
+        CHECK_EQ(values[i], s.substr(0, i));
+    }
+    CHECK_EQ(arena.size(), 55);
+
+    arena.clear();
+    auto first = arena.store(s.data(), s.data() + 5);
+    auto second = arena.store(s.data(), s.data() + 5);
+    CHECK_EQ(first.data() + first.size(), second.data());
+    CHECK_EQ(second, "01234");
+}
+
+TEST_CASE("converter test convert_column") {
+    ss::converter<ss::string_error> c;
+
+    c.split(buff("x,1,2.5"), ",");
+    CHECK_EQ(c.convert_column<double>(2), 2.5);
+    REQUIRE(c.valid());
+    CHECK_EQ(c.convert_column<ss::ir<int, 0, 9>>(1), 1);
+    REQUIRE(c.valid());
+    CHECK_EQ(c.convert_column<std::string>(0), "x");
+    REQUIRE(c.valid());
+
+    c.convert_column<int>(0);
+    CHECK_FALSE(c.valid());
+    CHECK_NE(c.error_msg().find("column 1"), std::string::npos);
+
+    c.convert_column<ss::ir<int, 2, 9>>(1);
+    CHECK_FALSE(c.valid());
+
+    c.convert_column<int>(3);
+    CHECK_FALSE(c.valid());
+}
+
+TEST_CASE("converter test utf8") {
+    ss::converter<ss::utf8, ss::string_error> c;
+    CHECK_EQ(c.convert<int, std::string>("1,\xc5\xa1"),
+             std::tuple{1, "\xc5\xa1"});
+    REQUIRE(c.valid());
+
+    c.convert<int, std::string>("1,a\xc5");
+    REQUIRE_FALSE(c.valid());
+    CHECK_NE(c.error_msg().find("position: 3"), std::string::npos);
+
+    std::vector<std::string> lines{"1,a", "2,\xff", "3,c"};
+    std::vector<std::tuple<int, std::string>> out(lines.size());
+    CHECK_EQ(c.convert_many<int, std::string>(lines.begin(), lines.end(),
+                                              out.begin()),
+             1);
+    CHECK_EQ(out[2], std::tuple{3, "c"});
+}
+
+TEST_CASE("converter test convert_many") {
+    std::vector<std::string> lines{"1,x", "2,y", "z,3", "4,\"w\""};
+    using value = std::tuple<int, std::string>;
+
+    {
+        ss::converter<ss::string_error> c;
+        std::vector<value> out(lines.size());
+        std::vector<size_t> invalid;
+        auto n = c.convert_many<int, std::string>(
+            lines.begin(), lines.end(), out.begin(), ",",
+            [&](size_t i) {
+                CHECK_FALSE(c.error_msg().empty());
+                invalid.push_back(i);
+            });
+        CHECK_EQ(n, 1);
+        CHECK_EQ(invalid, std::vector<size_t>{2});
+        CHECK_EQ(out[0], value{1, "x"});
+        CHECK_EQ(out[1], value{2, "y"});
+        CHECK_EQ(out[3], value{4, "\"w\""});
+    }
+
+    {
+        ss::converter<ss::quote<'"'>> c;
+        std::vector<std::string_view> views;
+        for (const auto& line : lines) {
+            views.emplace_back(line.data(), line.size());
+        }
+
+        // disjoint parts of the output
+        std::vector<value> out(lines.size());
+        CHECK_EQ(c.convert_many<int, std::string>(views.begin() + 2,
+                                                  views.end(),
+                                                  out.begin() + 2),
+                 1);
+        CHECK_EQ(c.convert_many<int, std::string>(views.begin(),
+                                                  views.begin() + 2,
+                                                  out.begin()),
+                 0);
+        CHECK_EQ(out[0], value{1, "x"});
+        CHECK_EQ(out[1], value{2, "y"});
+        CHECK_EQ(out[3], value{4, "w"});
+        CHECK_EQ(lines[3], "4,\"w\"");
+    }
+
+    {
+        ss::converter c;
+        const char* raw[] = {"1;2", "3;4"};
+        std::vector<std::tuple<int, int>> out;
+        CHECK_EQ(c.convert_many<int, int>(std::begin(raw), std::end(raw),
+                                          std::back_inserter(out), ";"),
+                 0);
+        CHECK_EQ(out, std::vector<std::tuple<int, int>>{{1, 2}, {3, 4}});
+    }
+}
@@ -0,0 +1,174 @@
+#include "test_helpers.hpp"
+
+#ifdef __cpp_impl_coroutine
+
+#include <deque>
+#include <fstream>
+#include <ss/async_parser.hpp>
+#include <ss/parser.hpp>
+
+namespace {
+// coroutine which starts immediately and is never awaited
+struct task {
+    struct promise_type {
+        task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+// resumes the suspended coroutines one at a time
+struct event_loop {
+    std::deque<std::coroutine_handle<>> ready;
+
+    void run() {
+        while (!ready.empty()) {
+            auto h = ready.front();
+            ready.pop_front();
+            h.resume();
+        }
+    }
+};
+
+// suspends the coroutine until the others have run
+struct reschedule {
+    event_loop* loop;
+
+    bool await_ready() noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) { loop->ready.push_back(h); }
+    void await_resume() noexcept {}
+};
+
+// returns the chunks one at a time, each one after a suspension
+struct chunk_source {
+    struct awaiter {
+        event_loop* loop;
+        std::string chunk;
+
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            loop->ready.push_back(h);
+        }
+        std::string await_resume() { return std::move(chunk); }
+    };
+
+    awaiter operator()() {
+        if (next == chunks.size()) {
+            return {loop, ""};
+        }
+        return {loop, chunks[next++]};
+    }
+
+    event_loop* loop;
+    std::vector<std::string> chunks;
+    size_t next{0};
+};
+} /* namespace */
+
+TEST_CASE("coroutine test parser rows") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,x\n2,y\njunk,z\n4,w\n";
+    }
+
+    ss::parser p{f.name, ","};
+    std::vector<std::tuple<int, std::string>> values;
+    size_t invalid = 0;
+    for (auto& value : p.rows<int, std::string>()) {
+        if (!p.valid()) {
+            ++invalid;
+            continue;
+        }
+        values.push_back(std::move(value));
+    }
+
+    CHECK(p.eof());
+    CHECK_EQ(invalid, 1);
+    std::vector<std::tuple<int, std::string>> expected{{1, "x"},
+                                                       {2, "y"},
+                                                       {4, "w"}};
+    CHECK_EQ(values, expected);
+}
+
+TEST_CASE("coroutine test async parser") {
+    event_loop loop;
+    chunk_source source{&loop,
+                        {"1,\"a\"\n2,", "\"b\n", "b\"\r\n# comment\n\n3",
+                         ",c\njunk,d\n5,\"e"}};
+
+    using parser = ss::async_parser<ss::quote<'"'>, ss::multiline,
+                                    ss::comment<'#'>, ss::ignore_empty,
+                                    ss::string_error>;
+    parser p{"chunks", ","};
+
+    std::vector<std::tuple<int, std::string>> values;
+    std::vector<std::string> errors;
+    size_t other_work = 0;
+
+    auto consume = [&]() -> task {
+        auto rows = p.rows<int, std::string>(std::ref(source));
+        while (auto row = co_await rows.next()) {
+            if (p.valid()) {
+                values.push_back(std::move(*row));
+            } else {
+                errors.push_back(p.error_msg());
+            }
+        }
+    };
+
+    // interleaved with the parsing on the same thread
+    auto work = [&]() -> task {
+        for (int i = 0; i < 3; ++i) {
+            ++other_work;
+            co_await reschedule{&loop};
+        }
+    };
+
+    consume();
+    work();
+    loop.run();
+
+    CHECK(p.eof());
+    CHECK_EQ(other_work, 3);
+    std::vector<std::tuple<int, std::string>> expected{{1, "a"},
+                                                       {2, "b\nb"},
+                                                       {3, "c"}};
+    CHECK_EQ(values, expected);
+    REQUIRE_EQ(errors.size(), 2);
+    CHECK_NE(errors[0].find("chunks 7: "), std::string::npos);
+    CHECK_NE(errors[1].find("chunks 8: "), std::string::npos);
+}
+
+TEST_CASE("coroutine test async parser utf8") {
+    event_loop loop;
+    chunk_source source{&loop, {"1,\xc5\xa1\n2,a\xc5\n", "3,b\n"}};
+
+    ss::async_parser<ss::utf8, ss::string_error> p{"chunks", ","};
+    std::vector<std::tuple<int, std::string>> values;
+    std::vector<std::string> errors;
+
+    auto consume = [&]() -> task {
+        auto rows = p.rows<int, std::string>(std::ref(source));
+        while (auto row = co_await rows.next()) {
+            if (p.valid()) {
+                values.push_back(std::move(*row));
+            } else {
+                errors.push_back(p.error_msg());
+            }
+        }
+    };
+
+    consume();
+    loop.run();
+
+    std::vector<std::tuple<int, std::string>> expected{{1, "\xc5\xa1"},
+                                                       {3, "b"}};
+    CHECK_EQ(values, expected);
+    REQUIRE_EQ(errors.size(), 1);
+    CHECK_NE(errors[0].find("chunks 2: invalid utf-8"), std::string::npos);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include "test_helpers.hpp"
+#include <fstream>
+#include <ss/converter.hpp>
+#include <ss/enum_map.hpp>
+#include <ss/parser.hpp>
+
+namespace {
+enum class status { ok, warning, error, unknown };
+
+constexpr ss::token<status> status_tokens[] = {{"OK", status::ok},
+                                               {"WARN", status::warning},
+                                               {"ERROR", status::error},
+                                               {"UNKNOWN", status::unknown}};
+
+using status_map = ss::enum_map<status_tokens>;
+using status_map_ci = ss::enum_map_ci<status_tokens>;
+
+enum class letter { a, b, c };
+constexpr ss::token<letter> letter_tokens[] = {{"a", letter::a}};
+
+constexpr ss::token<int> number_tokens[] = {
+    {"zero", 0},    {"one", 1},      {"two", 2},   {"three", 3},
+    {"four", 4},    {"five", 5},     {"six", 6},   {"seven", 7},
+    {"eight", 8},   {"nine", 9},     {"ten", 10},  {"eleven", 11},
+    {"twelve", 12}, {"thirteen", 13}, {"", -1}};
+
+template <typename Map>
+bool decode(const std::string& s, typename Map::enum_type& value) {
+    return Map::decode(s.data(), s.data() + s.size(), value);
+}
+} /* namespace */
+
+TEST_CASE("enum map test decode") {
+    status s{};
+    CHECK(decode<status_map>("OK", s));
+    CHECK_EQ(s, status::ok);
+    CHECK(decode<status_map>("WARN", s));
+    CHECK_EQ(s, status::warning);
+    CHECK(decode<status_map>("ERROR", s));
+    CHECK_EQ(s, status::error);
+    CHECK(decode<status_map>("UNKNOWN", s));
+    CHECK_EQ(s, status::unknown);
+
+    for (const auto& invalid :
+         {"", "ok", "OK ", " OK", "O", "OKK", "WARNING", "ERR", "unknown"}) {
+        s = status::unknown;
+        CHECK_FALSE(decode<status_map>(invalid, s));
+        CHECK_EQ(s, status::unknown);
+    }
+
+    letter l{};
+    CHECK(decode<ss::enum_map<letter_tokens>>("a", l));
+    CHECK_EQ(l, letter::a);
+    CHECK_FALSE(decode<ss::enum_map<letter_tokens>>("b", l));
+
+    int n = 0;
+    for (const auto& token : number_tokens) {
+        CHECK(decode<ss::enum_map<number_tokens>>(std::string{token.name}, n));
+        CHECK_EQ(n, token.value);
+    }
+    CHECK_FALSE(decode<ss::enum_map<number_tokens>>("fourteen", n));
+}
+
+TEST_CASE("enum map test decode case insensitive") {
+    status s{};
+    for (const auto& ok : {"OK", "ok", "Ok", "oK"}) {
+        s = status::unknown;
+        CHECK(decode<status_map_ci>(ok, s));
+        CHECK_EQ(s, status::ok);
+    }
+
+    CHECK(decode<status_map_ci>("wArN", s));
+    CHECK_EQ(s, status::warning);
+    CHECK(decode<status_map_ci>("error", s));
+    CHECK_EQ(s, status::error);
+
+    CHECK_FALSE(decode<status_map_ci>("o", s));
+    CHECK_FALSE(decode<status_map_ci>("warning", s));
+    CHECK_FALSE(decode<status_map_ci>("0K", s));
+}
+
+TEST_CASE("enum map test converter") {
+    ss::converter c;
+
+    auto [x, s] = c.convert<int, status_map>("1,WARN");
+    REQUIRE(c.valid());
+    CHECK_EQ(x, 1);
+    CHECK_EQ(s, status::warning);
+
+    c.convert<int, status_map>("1,warn");
+    CHECK_FALSE(c.valid());
+
+    auto s_ci = c.convert<status_map_ci>("warn");
+    REQUIRE(c.valid());
+    CHECK_EQ(s_ci, status::warning);
+
+    c.convert<status_map>("");
+    CHECK_FALSE(c.valid());
+}
+
+TEST_CASE("enum map test converter error message") {
+    ss::converter<ss::string_error> c;
+    c.convert<int, status_map>("1,FAIL");
+    REQUIRE_FALSE(c.valid());
+    CHECK_NE(c.error_msg().find("FAIL"), std::string::npos);
+}
+
+TEST_CASE("enum map test parser") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,OK\n2,error\n3,WARN\n4,FAIL\n";
+    }
+
+    ss::parser p{f.name, ","};
+    std::vector<std::pair<int, status>> values;
+    while (!p.eof()) {
+        auto [x, s] = p.get_next<int, status_map_ci>();
+        if (!p.valid()) {
+            break;
+        }
+        values.emplace_back(x, s);
+    }
+
+    std::vector<std::pair<int, status>> expected{{1, status::ok},
+                                                 {2, status::error},
+                                                 {3, status::warning}};
+    CHECK_EQ(values, expected);
+}
@@ -1,6 +1,8 @@
 #include "test_helpers.hpp"
 #include <algorithm>
+#include <cmath>
 #include <ss/extract.hpp>
+#include <ss/utf8.hpp>
 
 #define CHECK_FLOATING_CONVERSION(input, type)                                 \
     {                                                                          \
@@ -308,3 +310,92 @@ TEST_CASE("extract test functions for std::variant") {
         }
     }
 }
+
+TEST_CASE("extract test field classification") {
+    auto classify = [](const std::string& s) {
+        return ss::classify_field(s.c_str(), s.c_str() + s.size());
+    };
+    CHECK_EQ(classify(""), ss::field_kind::empty);
+    CHECK_EQ(classify("123"), ss::field_kind::digits);
+    CHECK_EQ(classify("-123"), ss::field_kind::negative_digits);
+    CHECK_EQ(classify("-"), ss::field_kind::negative_digits);
+    CHECK_EQ(classify("1.5e-3"), ss::field_kind::number);
+    CHECK_EQ(classify("--"), ss::field_kind::number);
+    CHECK_EQ(classify("12a"), ss::field_kind::other);
+    CHECK_EQ(classify("-inf"), ss::field_kind::other);
+}
+
+TEST_CASE("extract test std::variant with classified fields") {
+    auto extract = [](const std::string& s, auto& var) {
+        return ss::extract(s.c_str(), s.c_str() + s.size(), var);
+    };
+
+    {
+        std::variant<unsigned, int, double, std::string> var;
+        REQUIRE(extract("-5", var));
+        REQUIRE_VARIANT(var, -5, int);
+        REQUIRE(extract("5", var));
+        REQUIRE_VARIANT(var, 5u, unsigned);
+        REQUIRE(extract("-inf", var));
+        REQUIRE(std::holds_alternative<double>(var));
+        CHECK(std::isinf(std::get<double>(var)));
+        REQUIRE(extract("1e3", var));
+        REQUIRE_VARIANT(var, 1000.0, double);
+        REQUIRE(extract("99999999999", var));
+        REQUIRE_VARIANT(var, 99999999999.0, double);
+        REQUIRE(extract("", var));
+        REQUIRE_VARIANT(var, "", std::string);
+        REQUIRE(extract("-", var));
+        REQUIRE_VARIANT(var, 0, int);
+    }
+    {
+        std::variant<bool, char, int, std::string> var;
+        REQUIRE(extract("1", var));
+        REQUIRE_VARIANT(var, true, bool);
+        REQUIRE(extract("false", var));
+        REQUIRE_VARIANT(var, false, bool);
+        REQUIRE(extract("x", var));
+        REQUIRE_VARIANT(var, 'x', char);
+        REQUIRE(extract("12", var));
+        REQUIRE_VARIANT(var, 12, int);
+        REQUIRE(extract("fals", var));
+        REQUIRE_VARIANT(var, "fals", std::string);
+    }
+    {
+        std::variant<int, std::optional<int>> var;
+        REQUIRE(extract("x", var));
+        REQUIRE(std::holds_alternative<std::optional<int>>(var));
+        CHECK_FALSE(std::get<std::optional<int>>(var).has_value());
+    }
+}
+
+TEST_CASE("extract test utf8 validation") {
+    auto invalid_at = [](const std::string& s) {
+        return ss::find_invalid_utf8(s.data(), s.size());
+    };
+
+    for (const std::string s :
+         {"", "ascii only, long enough for words", "\xC3\xA9t\xC3\xA9",
+          "\xE2\x82\xAC 100", "\xF0\x9F\x98\x80\xF0\x9F\x98\x80 smiles",
+          "\xED\x9F\xBF", "\xEE\x80\x80", "\xF4\x8F\xBF\xBF",
+          "0123456789abcdef\xE2\x82\xAC" "0123456789"}) {
+        CHECK_EQ(invalid_at(s), s.size());
+    }
+
+    // overlong encodings
+    CHECK_EQ(invalid_at("ab\xC0\xAF"), 2);
+    CHECK_EQ(invalid_at("\xE0\x80\xAF"), 0);
+    CHECK_EQ(invalid_at("\xF0\x80\x80\xAF"), 0);
+    // surrogates
+    CHECK_EQ(invalid_at("\xED\xA0\x80"), 0);
+    // above U+10FFFF
+    CHECK_EQ(invalid_at("\xF4\x90\x80\x80"), 0);
+    CHECK_EQ(invalid_at("\xF5\x80\x80\x80"), 0);
+    // unexpected continuation and truncated sequences
+    CHECK_EQ(invalid_at("0123456789\x80"), 10);
+    CHECK_EQ(invalid_at("\xC3\xA9\xC3"), 2);
+    CHECK_EQ(invalid_at("\xE2\x82"), 0);
+    CHECK_EQ(invalid_at("\xE2\x82x"), 0);
+    // latin-1
+    CHECK_EQ(invalid_at("caf\xE9 au lait"), 3);
+}
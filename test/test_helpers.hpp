@@ -1,6 +1,11 @@
 #pragma once
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <string>
 
 #ifdef CMAKE_GITHUB_CI
 #include <doctest/doctest.h>
@@ -46,3 +51,23 @@ struct buffer {
 };
 
 [[maybe_unused]] inline buffer buff;
+
+inline std::string time_now_rand() {
+    std::stringstream ss;
+    auto t = std::time(nullptr);
+    auto tm = *std::localtime(&t);
+    ss << std::put_time(&tm, "%d%m%Y%H%M%S");
+    srand(time(nullptr));
+    return ss.str() + std::to_string(rand());
+}
+
+inline int i = 0;
+struct unique_file_name {
+    const std::string name;
+
+    unique_file_name()
+        : name{"random_" + std::to_string(i++) + time_now_rand() +
+               "_file.csv"} {}
+
+    ~unique_file_name() { std::filesystem::remove(name); }
+};
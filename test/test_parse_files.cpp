@@ -0,0 +1,152 @@
+#include "test_helpers.hpp"
+#include <atomic>
+#include <fstream>
+#include <ss/parse_files.hpp>
+
+namespace {
+using row = std::tuple<int, std::string>;
+
+std::vector<row> make_file(const std::string& file_name, size_t index,
+                           size_t rows) {
+    std::ofstream out{file_name};
+    std::vector<row> expected;
+    for (size_t i = 0; i < rows; ++i) {
+        int value = static_cast<int>(index * 1000 + i);
+        out << value << ",x" << value << "\n";
+        expected.emplace_back(value, "x" + std::to_string(value));
+    }
+    return expected;
+}
+
+template <typename Parser>
+std::vector<row> read_rows(Parser& p) {
+    std::vector<row> values;
+    for (const auto& value : p.template iterate<int, std::string>()) {
+        if (p.valid()) {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+} /* namespace */
+
+TEST_CASE("parser test open") {
+    unique_file_name f1;
+    unique_file_name f2;
+    auto expected1 = make_file(f1.name, 1, 50);
+    auto expected2 = make_file(f2.name, 2, 3);
+
+    ss::parser<ss::string_error> p{f1.name};
+    p.get_next<int, std::string>();
+    p.open(f2.name);
+    CHECK_EQ(read_rows(p), expected2);
+    CHECK_EQ(p.position().line_number, 3);
+
+    p.open(f1.name);
+    CHECK_EQ(read_rows(p), expected1);
+
+    p.open("does_not_exist.csv");
+    CHECK_FALSE(p.valid());
+    CHECK(p.eof());
+
+    p.open(f2.name);
+    CHECK(p.valid());
+    CHECK_EQ(read_rows(p), expected2);
+}
+
+TEST_CASE("parse_files test results in the order of the files") {
+    unique_file_name files[20];
+    std::vector<std::string> paths;
+    std::vector<std::vector<row>> expected;
+    for (size_t i = 0; i < std::size(files); ++i) {
+        paths.push_back(files[i].name);
+        expected.push_back(make_file(files[i].name, i, (i * 37) % 200));
+    }
+
+    for (size_t threads : {1, 3, 8}) {
+        auto results = ss::parse_files(
+            paths, [](ss::parser<>& p) { return read_rows(p); }, threads);
+        CHECK_EQ(results, expected);
+
+        auto merged = ss::merge_results(std::move(results));
+        CHECK_EQ(merged, ss::merge_results(expected));
+    }
+
+    std::atomic<size_t> rows{0};
+    ss::parse_files<ss::string_error>(
+        paths, [&](ss::parser<ss::string_error>& p) {
+            rows += read_rows(p).size();
+        });
+    CHECK_EQ(rows, ss::merge_results(expected).size());
+}
+
+TEST_CASE("parse_files test missing file") {
+    unique_file_name f;
+    make_file(f.name, 0, 10);
+
+    std::vector<std::string> paths{f.name, "does_not_exist.csv", f.name};
+    auto results = ss::parse_files<ss::string_error>(
+        paths,
+        [](ss::parser<ss::string_error>& p) {
+            return std::make_pair(p.valid(), read_rows(p).size());
+        },
+        2);
+
+    std::vector<std::pair<bool, size_t>> expected{
+        {true, 10}, {false, 0}, {true, 10}};
+    CHECK_EQ(results, expected);
+}
+
+TEST_CASE("parse_files test filters of each file") {
+    unique_file_name files[8];
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < std::size(files); ++i) {
+        paths.push_back(files[i].name);
+        make_file(files[i].name, i, 10);
+    }
+
+    std::atomic<size_t> filter_calls{0};
+    auto results = ss::parse_files(
+        paths,
+        [&](ss::parser<>& p) {
+            size_t limit = 5;
+            p.where<0, int>([&, limit](int value) {
+                ++filter_calls;
+                return static_cast<size_t>(value % 1000) < limit;
+            });
+            return read_rows(p).size();
+        },
+        2);
+
+    // the filters of a file are not applied to the next one
+    CHECK_EQ(results, std::vector<size_t>(std::size(files), 5));
+    CHECK_EQ(filter_calls, 10 * std::size(files));
+}
+
+TEST_CASE("parse_files test bool and non default constructible results") {
+    unique_file_name files[16];
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < std::size(files); ++i) {
+        paths.push_back(files[i].name);
+        make_file(files[i].name, i, i);
+    }
+
+    auto results = ss::parse_files(
+        paths, [](ss::parser<>& p) { return read_rows(p).size() % 2 == 0; },
+        4);
+    REQUIRE_EQ(results.size(), std::size(files));
+    for (size_t i = 0; i < results.size(); ++i) {
+        CHECK_EQ(results[i], i % 2 == 0);
+    }
+
+    struct rows {
+        explicit rows(size_t n) : n{n} {
+        }
+        size_t n;
+    };
+    auto counted = ss::parse_files(
+        paths, [](ss::parser<>& p) { return rows{read_rows(p).size()}; }, 4);
+    for (size_t i = 0; i < counted.size(); ++i) {
+        CHECK_EQ(counted[i].n, i);
+    }
+}
@@ -5,26 +5,7 @@
 #include <iomanip>
 #include <ss/parser.hpp>
 #include <sstream>
-
-std::string time_now_rand() {
-    std::stringstream ss;
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
-    ss << std::put_time(&tm, "%d%m%Y%H%M%S");
-    srand(time(nullptr));
-    return ss.str() + std::to_string(rand());
-}
-
-inline int i = 0;
-struct unique_file_name {
-    const std::string name;
-
-    unique_file_name()
-        : name{"random_" + std::to_string(i++) + time_now_rand() +
-               "_file.csv"} {}
-
-    ~unique_file_name() { std::filesystem::remove(name); }
-};
+#include <thread>
 
 void replace_all(std::string& s, const std::string& from,
                  const std::string& to) {
@@ -832,3 +813,630 @@ TEST_CASE("parser test multiline restricted") {
     }
     CHECK_EQ(i, data);
 }
+
+TEST_CASE("parser test dict_string") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        for (auto& i : {"ok,1", "error,2", "ok,3", "error,4", "ok,5"}) {
+            out << i << std::endl;
+        }
+    }
+
+    ss::parser p{f.name, ","};
+    std::vector<std::pair<ss::dict_string, int>> values;
+    for (auto&& [status, i] : p.iterate<ss::dict_string, int>()) {
+        values.emplace_back(status, i);
+    }
+
+    REQUIRE_EQ(values.size(), 5);
+    CHECK_EQ(p.dictionary().size(), 2);
+    for (const auto& [status, i] : values) {
+        CHECK_EQ(status.value, (i % 2 == 0) ? "error" : "ok");
+        CHECK_EQ(status.id, (i % 2 == 0) ? 1 : 0);
+        CHECK_EQ(p.dictionary()[status.id], status.value);
+    }
+}
+
+TEST_CASE("parser test arena_string") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 100; ++i) {
+            out << "name" << i << "," << i << std::endl;
+        }
+    }
+
+    ss::parser p{f.name, ","};
+    std::vector<std::pair<ss::arena_string, int>> values;
+    while (!p.eof()) {
+        auto [name, i] = p.get_next<ss::arena_string, int>();
+        REQUIRE(p.valid());
+        values.emplace_back(name, i);
+
+        // reset every 10 rows
+        if (values.size() == 10) {
+            for (const auto& [name, i] : values) {
+                CHECK_EQ(name.value, "name" + std::to_string(i));
+            }
+            values.clear();
+            p.arena().clear();
+        }
+    }
+    CHECK(values.empty());
+}
+
+TEST_CASE("parser test ignore_next") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,2,x" << std::endl;
+        out << "junk,\"ju\nnk\"" << std::endl;
+        out << "3,4,y" << std::endl;
+        out << "junk" << std::endl;
+        out << "5,6,z";
+    }
+
+    ss::parser<ss::multiline, ss::quote<'"'>> p{f.name, ","};
+    std::vector<X> i;
+    while (!p.eof()) {
+        i.push_back(p.get_object<X, int, double, std::string>());
+        REQUIRE(p.valid());
+        if (!p.eof()) {
+            CHECK(p.ignore_next());
+        }
+    }
+
+    std::vector<X> data = {{1, 2, "x"}, {3, 4, "y"}, {5, 6, "z"}};
+    CHECK_EQ(i, data);
+
+    ss::parser p_eof{f.name, ","};
+    for (size_t j = 0; j < 5; ++j) {
+        CHECK(p_eof.ignore_next());
+    }
+    CHECK_FALSE(p_eof.ignore_next());
+    CHECK(p_eof.eof());
+}
+
+TEST_CASE("parser test comments and empty lines") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "# i,d,s" << std::endl;
+        out << "1,2,x" << std::endl;
+        out << std::endl;
+        out << ";3,4,y" << std::endl;
+        out << "\r\n";
+        out << "5,6,\"z" << std::endl;
+        out << "#z\"" << std::endl;
+        out << "7,8,#" << std::endl;
+        out << "#";
+    }
+
+    ss::parser<ss::comment<'#', ';'>, ss::ignore_empty, ss::multiline,
+               ss::quote<'"'>>
+        p{f.name, ","};
+    std::vector<X> i;
+    for (auto&& a : p.iterate_object<X, int, double, std::string>()) {
+        REQUIRE(p.valid());
+        i.push_back(a);
+    }
+
+    std::vector<X> data = {{1, 2, "x"}, {5, 6, "z\n#z"}, {7, 8, "#"}};
+    for (auto& [_, __, s] : i) {
+        update_if_crlf(s);
+    }
+    CHECK_EQ(i, data);
+
+    ss::parser<ss::comment<'#'>> p_no_empty{f.name, ","};
+    size_t rows = 0;
+    while (!p_no_empty.eof()) {
+        p_no_empty.ignore_next();
+        ++rows;
+    }
+    // the empty lines and the row starting with ';' are not skipped
+    CHECK_EQ(rows, 6);
+}
+
+TEST_CASE("parser test where") {
+    unique_file_name f;
+    std::vector<X> data = {{1, 2, "x"}, {2, 3, "\\y"}, {3, 4, "z"},
+                           {4, 5, "\\x"}, {5, 6, "w"}, {6, 7, "x"},
+                           {8, 9, "v"}};
+    make_and_write(f.name, data);
+
+    {
+        ss::parser<ss::escape<'\\'>> p{f.name, ","};
+        p.where<2>([](std::string_view s) { return s != "x"; });
+        p.where<0, int>([](int i) { return i % 2 == 0; });
+
+        std::vector<X> i;
+        for (auto&& a : p.iterate_object<X, int, double, std::string>()) {
+            REQUIRE(p.valid());
+            i.push_back(a);
+        }
+
+        // the values are filtered once unescaped
+        std::vector<X> expected = {{2, 3, "y"}, {8, 9, "v"}};
+        CHECK_EQ(i, expected);
+    }
+
+    {
+        ss::parser p{f.name, ","};
+        size_t calls = 0;
+        p.where<0, ss::gt<int, 10>>([&](int) { return ++calls; });
+        CHECK(p.eof());
+        CHECK_EQ(calls, 0);
+    }
+}
+
+TEST_CASE("parser test where with dict_string") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        for (auto& i : {"ok,1", "error,2", "warn,3", "ok,4", "error,5"}) {
+            out << i << std::endl;
+        }
+    }
+
+    ss::parser p{f.name, ","};
+    auto [first, i] = p.get_next<ss::dict_string, int>();
+    CHECK_EQ(first.value, "ok");
+
+    p.where<0, ss::dict_string>(
+        [](const ss::dict_string& s) { return s.value != "warn"; });
+    std::vector<ss::dict_string> values{first};
+    for (auto&& [status, i] : p.iterate<ss::dict_string, int>()) {
+        values.push_back(status);
+    }
+
+    // the filter and the rows intern into the same dictionary
+    REQUIRE_EQ(values.size(), 4);
+    CHECK_EQ(p.dictionary().size(), 3);
+    for (const auto& status : values) {
+        CHECK_EQ(p.dictionary()[status.id], status.value);
+    }
+    CHECK_EQ(values[0].id, values[2].id);
+    CHECK_EQ(values[1].id, values[3].id);
+}
+
+TEST_CASE("parser test where with invalid rows") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,x" << std::endl;
+        out << "5" << std::endl;
+        out << "2,y" << std::endl;
+        out << "z,3" << std::endl;
+        out << "4,\"w" << std::endl;
+    }
+
+    ss::parser<ss::string_error, ss::quote<'"'>> p{f.name, ","};
+    p.where<1>([](std::string_view s) { return s != "x"; });
+    p.where<0, int>([](int i) { return i > 1; });
+
+    std::vector<std::tuple<int, std::string>> values;
+    std::vector<std::string> errors;
+    while (!p.eof()) {
+        auto value = p.get_next<int, std::string>();
+        if (p.valid()) {
+            values.push_back(value);
+        } else {
+            errors.push_back(p.error_msg());
+        }
+    }
+
+    std::vector<std::tuple<int, std::string>> expected = {{2, "y"}};
+    CHECK_EQ(values, expected);
+    REQUIRE_EQ(errors.size(), 2);
+    CHECK_NE(errors[0].find("columns"), std::string::npos);
+    CHECK_NE(errors[1].find("quote"), std::string::npos);
+}
+
+TEST_CASE("parser test next_row") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "circle,10" << std::endl;
+        out << "rectangle,2,x" << std::endl;
+        out << "\"square,3" << std::endl;
+        out << "rectangle,4,5.5" << std::endl;
+    }
+
+    ss::parser<ss::string_error, ss::quote<'"'>> p{f.name, ","};
+
+    auto row = p.next_row();
+    REQUIRE(p.valid());
+    REQUIRE_EQ(row.size(), 2);
+    CHECK_EQ(row[0], "circle");
+    CHECK_EQ(row.get<int>(1), 10);
+    CHECK(row.valid());
+    CHECK_EQ(&row.get<int>(1), &row.get<int>(1));
+    CHECK_EQ(row.get<std::string>(1), "10");
+    row.get<ss::ir<int, 0, 9>>(1);
+    CHECK_FALSE(row.valid());
+    CHECK_EQ(row.get<int>(1), 10);
+    CHECK(row.valid());
+
+    row = p.next_row();
+    REQUIRE(p.valid());
+    CHECK_EQ(row.size(), 3);
+    CHECK_EQ(row.get<int>(1), 2);
+    row.get<double>(2);
+    CHECK_FALSE(row.valid());
+    CHECK_NE(row.error_msg().find("column 3"), std::string::npos);
+    row.get<double>(3);
+    CHECK_FALSE(row.valid());
+
+    row = p.next_row();
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("quote"), std::string::npos);
+    CHECK_FALSE(row.valid());
+    CHECK_EQ(row.get<std::string>(1), "");
+    CHECK_FALSE(row.valid());
+    CHECK_EQ(row.error_msg(), p.error_msg());
+
+    row = p.next_row();
+    REQUIRE(p.valid());
+    CHECK_EQ(row.get<std::string>(0), "rectangle");
+    CHECK_EQ(row.get<double>(2), 5.5);
+    CHECK(row.valid());
+
+    CHECK(p.eof());
+    row = p.next_row();
+    CHECK_FALSE(p.valid());
+    CHECK_EQ(row.size(), 0);
+}
+
+TEST_CASE("parser test next_row invalid rows") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,a" << std::endl;
+        out << "2,\xc5" << std::endl;
+        out << "3,c" << std::endl;
+        out << "4,\"d\n\n\nd\"" << std::endl;
+    }
+
+    ss::parser<ss::string_error, ss::utf8, ss::multiline_restricted<1>,
+               ss::quote<'"'>>
+        p{f.name, ","};
+
+    auto row = p.next_row();
+    REQUIRE(p.valid());
+    CHECK(row.valid());
+    CHECK_EQ(row.get<std::string>(1), "a");
+    CHECK(row.valid());
+
+    // the columns of invalid rows are not converted
+    row = p.next_row();
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("utf-8"), std::string::npos);
+    CHECK_FALSE(row.valid());
+    CHECK_EQ(row.get<int>(0), 0);
+    CHECK_FALSE(row.valid());
+    CHECK_EQ(row.error_msg(), p.error_msg());
+
+    row = p.next_row();
+    REQUIRE(p.valid());
+    CHECK_EQ(row.get<int>(0), 3);
+    CHECK_EQ(row.get<std::string>(1), "c");
+    CHECK(row.valid());
+
+    row = p.next_row();
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("multiline limit"), std::string::npos);
+    CHECK_EQ(row.get<std::string>(0), "");
+    CHECK_FALSE(row.valid());
+    CHECK_EQ(row.error_msg(), p.error_msg());
+
+    ss::parser<ss::utf8> p_bool{f.name, ","};
+    p_bool.next_row();
+    auto row_bool = p_bool.next_row();
+    CHECK_FALSE(p_bool.valid());
+    row_bool.get<int>(0);
+    CHECK_FALSE(row_bool.valid());
+}
+
+TEST_CASE("parser test quarantine") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << "1,\"a\"\n"
+            << "x,\"b\"\"b\"\r\n"
+            << "3,\"c\n"
+            << "c\",extra\n"
+            << "4,d\n"
+            << "6,\"e";
+    }
+
+    std::vector<std::tuple<std::string, size_t, ss::error_code, size_t>>
+        rejected;
+    size_t blocks = 0;
+    ss::quarantine_sink sink{[&](const auto& rows) {
+                                 ++blocks;
+                                 for (const auto& r : rows) {
+                                     rejected.emplace_back(std::string{r.raw},
+                                                           r.line_number,
+                                                           r.code, r.column);
+                                 }
+                             },
+                             1};
+
+    ss::parser<ss::quote<'"'>, ss::multiline, ss::quarantine> p{f.name, ","};
+    p.set_quarantine_sink(sink);
+
+    std::vector<std::tuple<int, std::string>> values;
+    while (!p.eof()) {
+        auto value = p.get_next<int, std::string>();
+        if (p.valid()) {
+            values.push_back(value);
+        }
+    }
+
+    std::vector<std::tuple<int, std::string>> expected{{1, "a"}, {4, "d"}};
+    CHECK_EQ(values, expected);
+
+    using ec = ss::error_code;
+    decltype(rejected) expected_rejected{
+        {"x,\"b\"\"b\"", 2, ec::invalid_conversion, 0},
+        {"3,\"c\nc\",extra", 4, ec::number_of_columns, 2},
+        {"6,\"e", 6, ec::invalid_split, ss::no_column}};
+    CHECK_EQ(rejected, expected_rejected);
+    CHECK_EQ(blocks, 3);
+    CHECK_EQ(sink.rows(), 3);
+
+    // not quarantined since an alternative could be valid
+    ss::parser<ss::quarantine> p2{f.name, ","};
+    p2.set_quarantine_sink(sink);
+    p2.try_next<int, int>().or_else<int, std::string>();
+    p2.try_next<int, int>().or_else<std::string, std::string>();
+    CHECK_EQ(sink.rows(), 3);
+}
+
+TEST_CASE("parser test quarantine multiline limit") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << "1,\"a\nb\"\n"
+            << "2,\"c\nc\nc\nc\n"
+            << "3,d\n";
+    }
+
+    std::vector<ss::error_code> codes;
+    ss::quarantine_sink sink{[&](const auto& rows) {
+                                 for (const auto& r : rows) {
+                                     codes.push_back(r.code);
+                                 }
+                             },
+                             1};
+
+    ss::parser<ss::string_error, ss::quote<'"'>, ss::multiline_restricted<1>,
+               ss::quarantine>
+        p{f.name, ","};
+    p.set_quarantine_sink(sink);
+
+    CHECK_EQ(p.get_next<int, std::string>(), std::tuple{1, "a\nb"});
+    REQUIRE(p.valid());
+
+    p.get_next<int, std::string>();
+    REQUIRE_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("multiline limit reached"),
+             std::string::npos);
+    REQUIRE_EQ(codes.size(), 1);
+    CHECK_EQ(codes[0], ss::error_code::multiline_limit_reached);
+}
+
+TEST_CASE("parser test utf8") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << "1,caf\xC3\xA9\n"
+            << "2,caf\xE9\n"
+            << "3,\"\xE2\x82\xAC\n\xE2\x82\xAC\"\n"
+            << "4,\"\xE2\x82\n\xAC\"\n";
+    }
+
+    ss::parser<ss::utf8, ss::string_error, ss::quote<'"'>, ss::multiline> p{
+        f.name, ","};
+    std::vector<std::tuple<int, std::string>> values;
+    std::vector<std::string> errors;
+    while (!p.eof()) {
+        auto value = p.get_next<int, std::string>();
+        if (p.valid()) {
+            values.push_back(value);
+        } else {
+            errors.push_back(p.error_msg());
+        }
+    }
+
+    std::vector<std::tuple<int, std::string>> expected{
+        {1, "caf\xC3\xA9"}, {3, "\xE2\x82\xAC\n\xE2\x82\xAC"}};
+    CHECK_EQ(values, expected);
+    REQUIRE_EQ(errors.size(), 2);
+    CHECK_NE(errors[0].find("invalid utf-8 at position: 5"),
+             std::string::npos);
+    CHECK_NE(errors[1].find("invalid utf-8 at position: 3"),
+             std::string::npos);
+
+    // not validated unless enabled
+    ss::parser p2{f.name, ","};
+    p2.get_next<int, std::string>();
+    CHECK(p2.valid());
+    p2.get_next<int, std::string>();
+    CHECK(p2.valid());
+}
+
+TEST_CASE("parser test fixed width") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "James     65  2.5\n"
+            << "Maria      4 10.1  \n"
+            << "Tom      abc  1.0\n"
+            << "Ann       42\n";
+    }
+
+    ss::fixed_width_parser<ss::widths<10, 3, 5>, ss::trim<' '>,
+                           ss::string_error>
+        p{f.name};
+    std::vector<std::tuple<std::string, int, double>> values;
+    std::vector<std::string> errors;
+    while (!p.eof()) {
+        auto value = p.get_next<std::string, ss::ir<int, 0, 100>, double>();
+        if (p.valid()) {
+            values.push_back(value);
+        } else {
+            errors.push_back(p.error_msg());
+        }
+    }
+
+    std::vector<std::tuple<std::string, int, double>> expected{
+        {"James", 65, 2.5}, {"Maria", 4, 10.1}};
+    CHECK_EQ(values, expected);
+    CHECK_EQ(errors.size(), 2);
+
+    ss::fixed_width_parser<ss::widths<10, 3, 5>, ss::trim<' '>> p2{f.name};
+    std::vector<std::tuple<std::string, int>> names;
+    for (const auto& [name, age, grade] :
+         p2.iterate<std::string, int, ss::gt<double, 5>>()) {
+        if (p2.valid()) {
+            names.emplace_back(name, age);
+        }
+    }
+    std::vector<std::tuple<std::string, int>> expected_names{{"Maria", 4}};
+    CHECK_EQ(names, expected_names);
+}
+
+TEST_CASE("parser test follow") {
+    unique_file_name f;
+    std::ofstream out{f.name, std::ios::binary};
+    out << "1,a\n2,\"b" << std::flush;
+
+    ss::parser<ss::follow, ss::quote<'"'>, ss::multiline> p{f.name};
+    auto read_rows = [&p] {
+        std::vector<std::tuple<int, std::string>> values;
+        while (!p.eof()) {
+            auto value = p.get_next<int, std::string>();
+            if (p.valid()) {
+                values.push_back(value);
+            }
+        }
+        return values;
+    };
+
+    using rows = std::vector<std::tuple<int, std::string>>;
+    CHECK_EQ(read_rows(), rows{{1, "a"}});
+    CHECK_FALSE(p.wait_for_rows(std::chrono::milliseconds{10}));
+
+    // the record is not complete until its new line is written
+    out << "\nb\"" << std::flush;
+    CHECK_FALSE(p.wait_for_rows(std::chrono::milliseconds{10}));
+    out << "\n3,c" << std::flush;
+    REQUIRE(p.wait_for_rows(std::chrono::milliseconds{10}));
+    CHECK_EQ(read_rows(), rows{{2, "b\nb"}});
+    CHECK_EQ(p.position().line_number, 3);
+
+    std::thread writer{[&out] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        out << "\n4,d\n" << std::flush;
+    }};
+    CHECK(p.wait_for_rows(std::chrono::seconds{10}));
+    writer.join();
+    CHECK_EQ(read_rows(), rows{{3, "c"}, {4, "d"}});
+    CHECK_EQ(p.position().line_number, 5);
+}
+
+TEST_CASE("parser test follow after open") {
+    unique_file_name f1;
+    unique_file_name f2;
+    {
+        std::ofstream out{f1.name, std::ios::binary};
+        out << "1,a\n";
+    }
+    std::ofstream out{f2.name, std::ios::binary};
+    out << "2,bbbb\n3,cccc\n" << std::flush;
+
+    ss::parser<ss::follow> p{f1.name};
+    CHECK_EQ(p.get_next<int, std::string>(), std::tuple{1, "a"});
+    REQUIRE(p.eof());
+    CHECK_FALSE(p.wait_for_rows(std::chrono::milliseconds{10}));
+
+    p.open(f2.name);
+    CHECK_EQ(p.get_next<int, std::string>(), std::tuple{2, "bbbb"});
+    CHECK_EQ(p.get_next<int, std::string>(), std::tuple{3, "cccc"});
+    REQUIRE(p.eof());
+
+    std::thread writer{[&out] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        out << "4,d\n" << std::flush;
+    }};
+    CHECK(p.wait_for_rows(std::chrono::seconds{10}));
+    writer.join();
+    CHECK_EQ(p.get_next<int, std::string>(), std::tuple{4, "d"});
+    CHECK(p.valid());
+}
+
+size_t extract_called = 0;
+
+struct counted {
+    int value{0};
+};
+
+template <>
+inline bool ss::extract(const char* begin, const char* end, counted& c) {
+    ++extract_called;
+    return ss::extract(begin, end, c.value);
+}
+
+TEST_CASE("parser test composite memoizes columns") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "a,1,x\n"
+            << "b,2,3\n"
+            << "c,z,3\n"
+            << "d,y,y\n";
+    }
+
+    ss::parser<ss::string_error> p{f.name, ","};
+    std::vector<std::string> results;
+    std::vector<int> calls;
+    while (!p.eof()) {
+        extract_called = 0;
+        p.try_next<std::string, counted, counted>()
+            .or_else<std::string, counted, std::string>(
+                [&](const std::string& s, counted c, const std::string&) {
+                    results.push_back(s + std::to_string(c.value));
+                })
+            .or_else<std::string, std::string, counted>(
+                [&](const std::string& s, const std::string&, counted c) {
+                    results.push_back(s + std::to_string(c.value));
+                });
+        calls.push_back(extract_called);
+    }
+    CHECK_EQ(results, std::vector<std::string>{"a1", "c3"});
+    // the first conversion is not memoized, while the alternatives convert
+    // the second column only once
+    CHECK_EQ(calls, std::vector<int>{3, 2, 3, 3});
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("column 3"), std::string::npos);
+
+    // failed conversions are reported the same way when memoized
+    ss::parser<ss::string_error> p2{f.name, ","};
+    p2.ignore_next();
+    p2.ignore_next();
+    extract_called = 0;
+    p2.try_next<void, counted, void>()
+        .or_else<void, counted, void>()
+        .or_else<void, counted, void>();
+    CHECK_EQ(extract_called, 2);
+    CHECK_FALSE(p2.valid());
+    CHECK_NE(p2.error_msg().find("column 2: 'z'"), std::string::npos);
+
+    // conversions of different rows are not mixed up
+    p2.try_next<void, counted, void>()
+        .or_else<void, counted, void>()
+        .or_else<void, std::string, void>();
+    CHECK_EQ(extract_called, 4);
+}
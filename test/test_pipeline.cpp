@@ -0,0 +1,264 @@
+#include "test_helpers.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <ss/parser.hpp>
+#include <ss/pipeline.hpp>
+
+namespace {
+struct Y {
+    int i;
+    double d;
+    std::string s;
+
+    auto tied() const {
+        return std::tie(i, d, s);
+    }
+
+    bool operator==(const Y& other) const {
+        return tied() == other.tied();
+    }
+
+    bool operator<(const Y& other) const {
+        return tied() < other.tied();
+    }
+};
+
+struct slow {
+    int value;
+};
+
+template <typename... Matchers>
+std::vector<Y> parse_serial(const std::string& file_name) {
+    ss::parser<Matchers...> p{file_name, ","};
+    std::vector<Y> values;
+    while (!p.eof()) {
+        auto value = p.template get_object<Y, int, double, std::string>();
+        if (p.valid()) {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+} /* namespace */
+
+template <>
+inline bool ss::extract(const char* begin, const char* end, slow& s) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    return ss::extract(begin, end, s.value);
+}
+
+TEST_CASE("pipeline test ordered and unordered conversion") {
+    unique_file_name f;
+    std::vector<Y> data;
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 1000; ++i) {
+            data.push_back({i, i / 2.0, "x" + std::to_string(i)});
+            out << i << ',' << i / 2.0 << ",x" << i
+                << (i % 2 == 0 ? "\n" : "\r\n");
+        }
+    }
+
+    for (size_t threads : {1, 2, 4}) {
+        ss::pipeline p{f.name, ",", threads};
+        p.set_batch_size(7);
+        p.set_max_batches(3);
+
+        std::vector<Y> values;
+        p.for_each<int, double, std::string>(
+            [&](int i, double d, const std::string& s) {
+                values.push_back({i, d, s});
+            });
+
+        CHECK(p.valid());
+        CHECK(p.eof());
+        CHECK_EQ(values, data);
+    }
+
+    {
+        ss::pipeline p{f.name, ",", 4};
+        p.set_batch_size(13);
+        p.set_ordered(false);
+
+        std::mutex mutex;
+        std::vector<Y> values;
+        p.for_each_object<Y, int, double, std::string>([&](const Y& y) {
+            std::lock_guard lock{mutex};
+            values.push_back(y);
+        });
+
+        std::sort(values.begin(), values.end());
+        CHECK_EQ(values, data);
+    }
+}
+
+TEST_CASE("pipeline test invalid records") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,2,x" << std::endl;
+        out << "junk" << std::endl;
+        out << "3,4,y" << std::endl;
+    }
+
+    ss::pipeline<ss::string_error> p{f.name, ",", 2};
+    p.set_batch_size(1);
+
+    std::vector<Y> values;
+    p.for_each_object<Y, int, double, std::string>(
+        [&](Y&& y) { values.push_back(y); });
+
+    std::vector<Y> expected = {{1, 2, "x"}, {3, 4, "y"}};
+    CHECK_EQ(values, expected);
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find(" 2: "), std::string::npos);
+
+    ss::pipeline<ss::string_error> p_no_file{f.name + ".missing"};
+    CHECK_FALSE(p_no_file.valid());
+    CHECK(p_no_file.eof());
+}
+
+TEST_CASE("pipeline test first invalid record") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        for (int i = 1; i <= 40; ++i) {
+            out << (i == 20 || i == 21 ? "x" : std::to_string(i)) << std::endl;
+        }
+    }
+
+    // the second worker finds its invalid record long before the first one
+    ss::pipeline<ss::string_error> p{f.name, ",", 2};
+    p.set_batch_size(20);
+    p.set_ordered(false);
+    p.for_each<slow>([] {});
+
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find(" 20: "), std::string::npos);
+}
+
+TEST_CASE("pipeline test utf8") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,\xc5\xa1" << std::endl;
+        out << "2,a\xc5" << std::endl;
+        out << "3,b" << std::endl;
+    }
+
+    ss::pipeline<ss::utf8, ss::string_error> p{f.name, ",", 2};
+    std::vector<std::tuple<int, std::string>> values;
+    p.for_each<int, std::string>(
+        [&](std::tuple<int, std::string> t) { values.push_back(t); });
+
+    std::vector<std::tuple<int, std::string>> expected{{1, "\xc5\xa1"},
+                                                       {3, "b"}};
+    CHECK_EQ(values, expected);
+    CHECK_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find("invalid utf-8 at position: 3"),
+             std::string::npos);
+}
+
+TEST_CASE("pipeline test dict_string and arena_string") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 1000; ++i) {
+            out << "status" << i % 3 << ",name" << i << "," << i << std::endl;
+        }
+    }
+
+    for (bool ordered : {true, false}) {
+        ss::pipeline<> p{f.name, ",", 4};
+        p.set_batch_size(7);
+        p.set_ordered(ordered);
+
+        std::mutex mutex;
+        std::vector<std::tuple<ss::dict_string, ss::arena_string, int>> values;
+        p.for_each<ss::dict_string, ss::arena_string, int>(
+            [&](ss::dict_string status, ss::arena_string name, int i) {
+                std::lock_guard lock{mutex};
+                values.emplace_back(status, name, i);
+            });
+        REQUIRE(p.valid());
+        REQUIRE_EQ(values.size(), 1000);
+
+        // the values are read once the workers are gone
+        CHECK_EQ(p.dictionary().size(), 3);
+        std::vector<size_t> ids(3, p.dictionary().size());
+        for (const auto& [status, name, i] : values) {
+            CHECK_EQ(status.value, "status" + std::to_string(i % 3));
+            CHECK_EQ(name.value, "name" + std::to_string(i));
+            CHECK_EQ(p.dictionary()[status.id], status.value);
+            if (ids[i % 3] == 3) {
+                ids[i % 3] = status.id;
+            }
+            CHECK_EQ(status.id, ids[i % 3]);
+        }
+    }
+}
+
+TEST_CASE("pipeline test multiline records") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "1,2,\"just\n\nstrings\"" << std::endl;
+        out << "3,4,\"ju\n\r\n\nnk\"" << std::endl;
+        out << "5,6,just\\\n\\\r\nstrings" << std::endl;
+        out << "7,8,ju\\\n\\\n\\\nnk" << std::endl;
+        out << "9,10,\"just\\\n\nstrings\"" << std::endl;
+        out << "11,12,\"ju\\\n|\n\n\n\n\nk\"" << std::endl;
+        out << "13,14,\"ju\\\n\\\n15,16\"\\\n\\\\\n\nnk\"" << std::endl;
+        out << "17,18,\"ju\\\n\\\n\\\n\\\\\n\nnk\"" << std::endl;
+        out << "19,20,  \"just\"\"\" , strings" << std::endl;
+        out << "21,22,\"unterminated" << std::endl;
+    }
+
+    auto check = [&](auto setup) {
+        using setup_t = decltype(setup);
+        std::vector<Y> values;
+        ss::pipeline<setup_t> p{f.name, ",", 3};
+        p.set_batch_size(2);
+        p.template for_each_object<Y, int, double, std::string>(
+            [&](const Y& y) { values.push_back(y); });
+
+        CHECK_FALSE(values.empty());
+        CHECK_EQ(values, parse_serial<setup_t>(f.name));
+        CHECK_FALSE(p.valid());
+    };
+
+    check(ss::setup<ss::multiline, ss::quote<'"'>, ss::escape<'\\'>>{});
+    check(ss::setup<ss::multiline, ss::quote<'"'>, ss::trim<' '>>{});
+    check(ss::setup<ss::multiline, ss::escape<'\\'>>{});
+    check(ss::setup<ss::multiline_restricted<2>, ss::quote<'"'>,
+                    ss::escape<'\\'>>{});
+}
+
+TEST_CASE("pipeline test comments and empty lines") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "# i,d,s" << std::endl;
+        out << "1,2,x" << std::endl;
+        out << std::endl;
+        out << "3,4,\"y" << std::endl;
+        out << "#y\"" << std::endl;
+        out << "#";
+    }
+
+    using setup = ss::setup<ss::comment<'#'>, ss::ignore_empty,
+                            ss::multiline, ss::quote<'"'>>;
+    ss::pipeline<setup> p{f.name, ",", 2};
+    p.set_batch_size(1);
+
+    std::vector<Y> values;
+    p.for_each_object<Y, int, double, std::string>(
+        [&](const Y& y) { values.push_back(y); });
+
+    CHECK(p.valid());
+    CHECK_EQ(values, parse_serial<setup>(f.name));
+    CHECK_EQ(values.size(), 2);
+}
@@ -0,0 +1,111 @@
+#include "test_helpers.hpp"
+#include <fstream>
+#include <ss/parser.hpp>
+#include <ss/sniffer.hpp>
+
+namespace {
+ss::dialect sniff(const std::string& content, size_t sample_size = 1024) {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << content;
+    }
+    return ss::sniff(f.name, sample_size);
+}
+} /* namespace */
+
+TEST_CASE("sniffer test delimiter") {
+    for (auto delim : {",", ";", "\t", "|", ":"}) {
+        std::string content;
+        for (int i = 0; i < 10; ++i) {
+            content.append("a b")
+                .append(delim)
+                .append(std::to_string(i))
+                .append(delim)
+                .append("2.5\n");
+        }
+
+        auto d = sniff(content);
+        REQUIRE(d.valid);
+        CHECK_EQ(d.delimiter, delim);
+        CHECK_EQ(d.columns, 3);
+        CHECK_EQ(d.quote, '\0');
+        CHECK_EQ(d.escape, '\0');
+        CHECK_FALSE(d.crlf);
+        CHECK_FALSE(d.header);
+        CHECK_FALSE(d.multiline);
+    }
+
+    auto d = sniff("x\ny\nz");
+    REQUIRE(d.valid);
+    CHECK_EQ(d.columns, 1);
+    CHECK_EQ(d.delimiter, ss::default_delimiter);
+
+    CHECK_FALSE(ss::sniff("missing_file.csv").valid);
+}
+
+TEST_CASE("sniffer test quote escape and header") {
+    {
+        auto d = sniff("name;age;note\r\n"
+                       "\"James; Bailey\";65;\"it's\"\r\n"
+                       "\"Ann\";30;\"two\r\nlines\"\r\n"
+                       "Bob;41;ok\r\n");
+        REQUIRE(d.valid);
+        CHECK_EQ(d.delimiter, ";");
+        CHECK_EQ(d.quote, '"');
+        CHECK_EQ(d.escape, '\0');
+        CHECK(d.crlf);
+        CHECK(d.header);
+        CHECK(d.multiline);
+        CHECK_EQ(d.columns, 3);
+    }
+    {
+        auto d = sniff("Mary's,1\nJohn's,2\nx,3\n");
+        CHECK_EQ(d.delimiter, ",");
+        CHECK_EQ(d.quote, '\0');
+        CHECK_FALSE(d.header);
+    }
+    {
+        auto d = sniff("a\\|b|1\nc|2\nd\\\\|3\n");
+        CHECK_EQ(d.delimiter, "|");
+        CHECK_EQ(d.escape, '\\');
+        CHECK_EQ(d.columns, 2);
+    }
+    {
+        // the last row is cut off by the sample size
+        auto d = sniff("1,2,3\n4,5,6\n7,8,9\n10,1", 20);
+        CHECK_EQ(d.columns, 3);
+    }
+}
+
+TEST_CASE("sniffer test visit") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "id|name" << std::endl;
+        out << "1|\"just" << std::endl;
+        out << "strings\"" << std::endl;
+        out << "2|\\|x" << std::endl;
+    }
+
+    auto d = ss::sniff(f.name);
+    REQUIRE(d.valid);
+    CHECK(d.header);
+
+    auto values = d.visit([&](auto setup) {
+        ss::parser<decltype(setup)> p{f.name, d.delimiter};
+        if (d.header) {
+            p.ignore_next();
+        }
+
+        std::vector<std::pair<int, std::string>> values;
+        for (auto&& [i, s] : p.template iterate<int, std::string>()) {
+            values.emplace_back(i, s);
+        }
+        return values;
+    });
+
+    std::vector<std::pair<int, std::string>> expected = {{1, "just\nstrings"},
+                                                         {2, "|x"}};
+    CHECK_EQ(values, expected);
+}
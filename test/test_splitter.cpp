@@ -914,3 +914,106 @@ TEST_CASE("splitter test with quote and escape, trim_left and trim_right") {
                           ss::trim_right<'-'>>(p, delims);
     }
 }
+
+TEST_CASE("splitter test character class table") {
+    using setup = ss::setup<ss::quote<'"'>, ss::escape<'\\', '#'>,
+                            ss::trim_left<' ', '\t'>, ss::trim_right<' '>>;
+    constexpr auto& classes = setup::char_classes;
+
+    static_assert(classes['"'] == ss::char_class::quote);
+    static_assert(classes['\\'] == ss::char_class::escape);
+    static_assert(classes['#'] == ss::char_class::escape);
+    static_assert(classes['\t'] == ss::char_class::trim_left);
+    static_assert(classes[' '] ==
+                  (ss::char_class::trim_left | ss::char_class::trim_right));
+    static_assert(classes['\0'] == ss::char_class::terminator);
+    static_assert(classes['a'] == ss::char_class::none);
+    static_assert(classes[','] == ss::char_class::none);
+
+    CHECK(ss::escape<'\\', '#'>::match('#'));
+    CHECK(ss::escape<'\\', '#'>::match('\\'));
+    CHECK_FALSE(ss::escape<'\\', '#'>::match('\0'));
+    CHECK_FALSE(ss::escape<'\\', '#'>::match(static_cast<char>(0xff)));
+
+    // the delimiter may change between splits
+    ss::splitter<setup> s;
+    CHECK_EQ(words(s.split(buff("a,b; c"), ",")),
+             std::vector<std::string>{"a", "b; c"});
+    CHECK_EQ(words(s.split(buff("a,b; c"), ";")),
+             std::vector<std::string>{"a,b", "c"});
+    CHECK_EQ(words(s.split(buff("a,b;; c"), ";;")),
+             std::vector<std::string>{"a,b", "c"});
+    CHECK_EQ(words(s.split(buff(" \"a,b\" ,c"), ",")),
+             std::vector<std::string>{"a,b", "c"});
+}
+
+TEST_CASE("splitter test with long runs of spacing") {
+    const std::string spaces(1000, ' ');
+    const std::string line = spaces + "a" + spaces + "b" + spaces + "," +
+                             spaces + "\\ c" + spaces + "," + spaces;
+
+    {
+        ss::splitter<ss::trim<' '>, ss::escape<'\\'>> s;
+        CHECK_EQ(words(s.split(buff(line.c_str()))),
+                 std::vector<std::string>{"a" + spaces + "b", " c", ""});
+    }
+    {
+        ss::splitter<ss::trim_right<' '>> s;
+        CHECK_EQ(words(s.split(buff(line.c_str()))),
+                 std::vector<std::string>{spaces + "a" + spaces + "b",
+                                          spaces + "\\ c", ""});
+    }
+    {
+        ss::splitter<ss::trim_left<' '>> s;
+        CHECK_EQ(words(s.split(buff(line.c_str()))),
+                 std::vector<std::string>{"a" + spaces + "b" + spaces,
+                                          "\\ c" + spaces, ""});
+    }
+}
+
+TEST_CASE("splitter test with many escapes within a column") {
+    std::string quoted = "\"";
+    std::string escaped;
+    std::string expected_quoted;
+    std::string expected_escaped;
+    for (size_t i = 0; i < 200; ++i) {
+        auto key = "k" + std::to_string(i);
+        quoted += "\"\"" + key + "\"\":\\\"";
+        escaped += key + "\\,\\\\";
+        expected_quoted += "\"" + key + "\":\"";
+        expected_escaped += key + ",\\";
+    }
+    quoted += "\"";
+
+    ss::splitter<ss::quote<'"'>, ss::escape<'\\'>> s;
+    CHECK_EQ(words(s.split(buff((quoted + "," + escaped).c_str()))),
+             std::vector<std::string>{expected_quoted, expected_escaped});
+}
+
+TEST_CASE("splitter test with fixed widths") {
+    {
+        ss::splitter<ss::widths<3, 2, 4>> s;
+        CHECK_EQ(words(s.split(buff("abcdefghi"))),
+                 std::vector<std::string>{"abc", "de", "fghi"});
+        CHECK_EQ(words(s.split(buff("abcdefghijkl"))),
+                 std::vector<std::string>{"abc", "de", "fghi"});
+        CHECK_EQ(words(s.split(buff("abcdef"))),
+                 std::vector<std::string>{"abc", "de", "f"});
+        CHECK_EQ(words(s.split(buff("ab"))),
+                 std::vector<std::string>{"ab", "", ""});
+        CHECK_EQ(words(s.split(buff("a,cd,fg,i"), ",")),
+                 std::vector<std::string>{"a,c", "d,", "fg,i"});
+    }
+    {
+        ss::splitter<ss::widths<4, 3, 5>, ss::trim<' '>> s;
+        CHECK_EQ(words(s.split(buff(" ab   1  x y"))),
+                 std::vector<std::string>{"ab", "1", "x y"});
+        CHECK_EQ(words(s.split(buff("    "))),
+                 std::vector<std::string>{"", "", ""});
+    }
+    {
+        ss::splitter<ss::widths<3, 3>, ss::trim_right<' '>> s;
+        CHECK_EQ(words(s.split(buff(" a  b "))),
+                 std::vector<std::string>{" a", " b"});
+    }
+}
@@ -0,0 +1,179 @@
+#include "test_helpers.hpp"
+#include <fstream>
+#include <ss/parser.hpp>
+
+namespace {
+std::string utf16(const std::u16string& s, bool big_endian) {
+    std::string out;
+    for (char16_t c : s) {
+        unsigned char low = c & 0xFF;
+        unsigned char high = c >> 8;
+        out.push_back(big_endian ? high : low);
+        out.push_back(big_endian ? low : high);
+    }
+    return out;
+}
+
+void write(const std::string& file_name, const std::string& data) {
+    std::ofstream out{file_name, std::ios::binary};
+    out << data;
+}
+
+template <typename... Ts>
+std::vector<std::tuple<std::string, int>> read_all(
+    const std::string& file_name,
+    ss::encoding encoding = ss::encoding::detect) {
+    ss::parser<Ts...> p{file_name, ",", encoding};
+    std::vector<std::tuple<std::string, int>> values;
+    while (!p.eof()) {
+        auto value = p.template get_next<std::string, int>();
+        if (p.valid()) {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+} /* namespace */
+
+TEST_CASE("transcoder test utf-16") {
+    std::u16string text = u"name,age\r\n"
+                          u"Renée,30\r\n"
+                          u"\"\U0001F600 long enough for whole words\",4\r\n"
+                          u"€中,5";
+    std::vector<std::tuple<std::string, int>> expected{
+        {"Ren\xC3\xA9" "e", 30},
+        {"\xF0\x9F\x98\x80 long enough for whole words", 4},
+        {"\xE2\x82\xAC\xE4\xB8\xAD", 5}};
+
+    unique_file_name f;
+    for (bool big_endian : {false, true}) {
+        std::string bom = big_endian ? "\xFE\xFF" : "\xFF\xFE";
+        write(f.name, bom + utf16(text, big_endian));
+
+        ss::parser<ss::quote<'"'>> p{f.name, ","};
+        p.ignore_next();
+        auto position = p.position();
+        CHECK_EQ(position.offset, 2 + 2 * 10);
+
+        std::vector<std::tuple<std::string, int>> values;
+        while (!p.eof()) {
+            values.push_back(p.get_next<std::string, int>());
+            REQUIRE(p.valid());
+        }
+        CHECK_EQ(values, expected);
+
+        p.seek(position);
+        CHECK_EQ(p.get_next<std::string, int>(), expected[0]);
+
+        // without a byte order mark
+        write(f.name, utf16(text, big_endian));
+        auto encoding =
+            big_endian ? ss::encoding::utf16be : ss::encoding::utf16le;
+        CHECK_EQ(read_all<ss::quote<'"'>>(f.name, encoding), expected);
+    }
+
+    // unpaired surrogates and a truncated unit are replaced
+    write(f.name, utf16(u"a\xD800,1\nb\xDC00,2\n", false));
+    auto values = read_all(f.name, ss::encoding::utf16le);
+    std::vector<std::tuple<std::string, int>> replaced{
+        {"a\xEF\xBF\xBD", 1}, {"b\xEF\xBF\xBD", 2}};
+    CHECK_EQ(values, replaced);
+
+    write(f.name, utf16(u"x", false) + "y");
+    ss::parser p{f.name, ",", ss::encoding::utf16le};
+    CHECK_EQ(p.get_next<std::string>(), "x\xEF\xBF\xBD");
+}
+
+TEST_CASE("transcoder test single byte encodings") {
+    unique_file_name f;
+    write(f.name, "caf\xE9 au lait,1\n\x80 and \x93quotes\x94,2\n");
+
+    auto latin1 = read_all(f.name, ss::encoding::latin1);
+    std::vector<std::tuple<std::string, int>> expected_latin1{
+        {"caf\xC3\xA9 au lait", 1}, {"\xC2\x80 and \xC2\x93quotes\xC2\x94", 2}};
+    CHECK_EQ(latin1, expected_latin1);
+
+    auto windows1252 = read_all(f.name, ss::encoding::windows1252);
+    std::vector<std::tuple<std::string, int>> expected_windows1252{
+        {"caf\xC3\xA9 au lait", 1},
+        {"\xE2\x82\xAC and \xE2\x80\x9Cquotes\xE2\x80\x9D", 2}};
+    CHECK_EQ(windows1252, expected_windows1252);
+}
+
+TEST_CASE("transcoder test utf-8 byte order mark") {
+    unique_file_name f;
+    write(f.name, "\xEF\xBB\xBFname,1\nx,2\n");
+
+    std::vector<std::tuple<std::string, int>> expected{{"name", 1}, {"x", 2}};
+    CHECK_EQ(read_all(f.name), expected);
+
+    ss::parser p{f.name, ","};
+    CHECK_EQ(p.position().offset, 3);
+
+    // the byte order mark is kept if the encoding is different
+    auto latin1 = read_all(f.name, ss::encoding::latin1);
+    REQUIRE_EQ(latin1.size(), 2);
+    CHECK_EQ(std::get<0>(latin1[0]), "\xC3\xAF\xC2\xBB\xC2\xBFname");
+}
+
+TEST_CASE("transcoder test multiple blocks") {
+    unique_file_name f;
+    std::u16string text;
+    for (int i = 0; i < 20000; ++i) {
+        auto n = std::to_string(i);
+        text += u"\U0001F600 row \xE9 ";
+        text += std::u16string(n.begin(), n.end());
+        text += u"," + std::u16string(n.begin(), n.end()) + u"\n";
+    }
+    write(f.name, utf16(text, true));
+
+    ss::parser p{f.name, ",", ss::encoding::utf16be};
+    std::vector<ss::position> positions;
+    int i = 0;
+    while (!p.eof()) {
+        positions.push_back(p.position());
+        auto [s, n] = p.get_next<std::string, int>();
+        REQUIRE(p.valid());
+        CHECK_EQ(n, i);
+        CHECK_EQ(s, "\xF0\x9F\x98\x80 row \xC3\xA9 " + std::to_string(i));
+        ++i;
+    }
+    CHECK_EQ(i, 20000);
+
+    for (int j : {12345, 7, 19999}) {
+        p.seek(positions[j]);
+        CHECK_EQ(std::get<1>(p.get_next<std::string, int>()), j);
+    }
+}
+
+TEST_CASE("transcoder test quarantine") {
+    unique_file_name f;
+    write(f.name, "\xFF\xFE" + utf16(u"a,1\r\nR\xE9" u"e,x\r\n"
+                                   u"\"c\nc\",3,4\nd,4",
+                                   false));
+
+    std::vector<std::tuple<std::string, size_t>> rejected;
+    ss::quarantine_sink sink{[&](const auto& rows) {
+        for (const auto& r : rows) {
+            rejected.emplace_back(std::string{r.raw}, r.line_number);
+        }
+    }};
+
+    ss::parser<ss::quote<'"'>, ss::multiline, ss::quarantine> p{f.name, ","};
+    p.set_quarantine_sink(sink);
+    std::vector<std::tuple<std::string, int>> values;
+    while (!p.eof()) {
+        auto value = p.get_next<std::string, int>();
+        if (p.valid()) {
+            values.push_back(value);
+        }
+    }
+    sink.flush();
+
+    std::vector<std::tuple<std::string, int>> expected{{"a", 1}, {"d", 4}};
+    CHECK_EQ(values, expected);
+    // the rows are kept converted to utf-8
+    std::vector<std::tuple<std::string, size_t>> expected_rejected{
+        {"R\xC3\xA9" "e,x", 2}, {"\"c\nc\",3,4", 4}};
+    CHECK_EQ(rejected, expected_rejected);
+}
@@ -0,0 +1,206 @@
+#include "test_helpers.hpp"
+#include <fstream>
+#include <ss/parser.hpp>
+#include <ss/zone_map.hpp>
+
+TEST_CASE("zone map test position and seek") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << "1,x\n# comment\n2,\"y\r\ny\"\r\n3,z";
+    }
+
+    ss::parser<ss::string_error, ss::comment<'#'>, ss::multiline,
+               ss::quote<'"'>>
+        p{f.name, ","};
+    std::vector<ss::position> positions;
+    std::vector<std::tuple<int, std::string>> values;
+    while (!p.eof()) {
+        positions.push_back(p.position());
+        values.push_back(p.get_next<int, std::string>());
+        REQUIRE(p.valid());
+    }
+
+    REQUIRE_EQ(positions.size(), 3);
+    CHECK_EQ(positions[0].offset, 0);
+    CHECK_EQ(positions[1].offset, 14);
+    CHECK_EQ(positions[1].line_number, 2);
+    CHECK_EQ(positions[2].offset, 24);
+    CHECK_EQ(positions[2].line_number, 4);
+
+    for (size_t i : {2, 0, 1}) {
+        p.seek(positions[i]);
+        CHECK_FALSE(p.eof());
+        CHECK_EQ(p.get_next<int, std::string>(), values[i]);
+    }
+
+    p.seek(positions[2]);
+    p.get_next<int, int>();
+    REQUIRE_FALSE(p.valid());
+    CHECK_NE(p.error_msg().find(" 5: "), std::string::npos);
+}
+
+TEST_CASE("zone map test ranges") {
+    unique_file_name f;
+    ss::zone_map<int> zm{10};
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 100; ++i) {
+            out << i << ',' << (i % 10 == 3 ? "" : std::to_string(i % 30))
+                << std::endl;
+        }
+    }
+
+    {
+        ss::parser p{f.name, ","};
+        while (!p.eof()) {
+            auto position = p.position();
+            auto [i, value] = p.get_next<int, std::optional<int>>();
+            REQUIRE(p.valid());
+            if (value) {
+                zm.add(position, *value);
+            } else {
+                zm.add_null(position);
+            }
+        }
+    }
+
+    REQUIRE_EQ(zm.zones().size(), 10);
+    CHECK_EQ(zm.zones()[1].min, 10);
+    CHECK_EQ(zm.zones()[1].max, 19);
+    CHECK_EQ(zm.zones()[1].nulls, 1);
+    CHECK_EQ(zm.zones()[1].begin.line_number, 10);
+
+    auto read = [&](const ss::zone_map<int>& zm, int min, int max) {
+        ss::parser p{f.name, ","};
+        p.restrict_to(zm.ranges(min, max));
+        std::vector<int> rows;
+        for (auto&& [i, value] : p.iterate<int, std::optional<int>>()) {
+            if (value && *value >= min && *value <= max) {
+                rows.push_back(i);
+            }
+        }
+        return rows;
+    };
+
+    // zones 1, 2, 4, 5, 7, and 8
+    CHECK_EQ(zm.ranges(12, 25).size(), 3);
+    CHECK_EQ(zm.ranges(12, 25)[0].rows, 20);
+    CHECK_EQ(read(zm, 12, 25),
+             std::vector<int>{12, 14, 15, 16, 17, 18, 19, 20, 21, 22, 24, 25,
+                              42, 44, 45, 46, 47, 48, 49, 50, 51, 52, 54, 55,
+                              72, 74, 75, 76, 77, 78, 79, 80, 81, 82, 84, 85});
+    CHECK(zm.ranges(30, 40).empty());
+    CHECK(read(zm, 30, 40).empty());
+
+    unique_file_name sidecar;
+    REQUIRE(zm.save(sidecar.name, f.name));
+
+    ss::zone_map<int> loaded;
+    REQUIRE(loaded.load(sidecar.name, f.name));
+    CHECK_EQ(loaded.zone_rows(), 10);
+    REQUIRE_EQ(loaded.zones().size(), zm.zones().size());
+    CHECK_EQ(read(loaded, 0, 1),
+             std::vector<int>{0, 1, 30, 31, 60, 61, 90, 91});
+
+    ss::zone_map<double> wrong_type;
+    CHECK_FALSE(wrong_type.load(sidecar.name, f.name));
+    CHECK_FALSE(wrong_type.load(sidecar.name + ".missing", f.name));
+    CHECK_FALSE(loaded.load(sidecar.name, f.name + ".missing"));
+
+    // zones which do not match the size of the sidecar
+    {
+        std::fstream out{sidecar.name,
+                         std::ios::binary | std::ios::in | std::ios::out};
+        out.seekp(24);
+        out << std::string(8, '\xff');
+    }
+    CHECK_FALSE(loaded.load(sidecar.name, f.name));
+    REQUIRE(zm.save(sidecar.name, f.name));
+
+    // the sidecar of an older version of the file is ignored
+    {
+        std::ofstream out{f.name, std::ios::app};
+        out << "100,30" << std::endl;
+    }
+    ss::zone_map<int> outdated;
+    CHECK_FALSE(outdated.load(sidecar.name, f.name));
+    CHECK(outdated.zones().empty());
+}
+
+TEST_CASE("zone map test build_zone_map") {
+    unique_file_name f;
+    {
+        std::ofstream out{f.name};
+        out << "# i,value" << std::endl;
+        for (int i = 0; i < 95; ++i) {
+            // columns which cannot be converted are counted as nulls too
+            out << i << ','
+                << (i % 10 == 3 ? ""
+                    : i == 57   ? "x"
+                                : std::to_string(i % 30))
+                << std::endl;
+        }
+    }
+
+    using setup = ss::setup<ss::comment<'#'>>;
+    ss::zone_map<int> expected{10};
+    {
+        ss::parser<setup> p{f.name, ","};
+        while (!p.eof()) {
+            auto position = p.position();
+            auto [i, value] = p.get_next<int, std::optional<int>>();
+            REQUIRE(p.valid());
+            if (value) {
+                expected.add(position, *value);
+            } else {
+                expected.add_null(position);
+            }
+        }
+    }
+
+    ss::parser<setup> p{f.name, ","};
+    auto zm = p.build_zone_map<int>(1, 10);
+    CHECK(p.eof());
+    CHECK_EQ(zm.zone_rows(), 10);
+    REQUIRE_EQ(zm.zones().size(), 10);
+    for (size_t i = 0; i < zm.zones().size(); ++i) {
+        const auto& z = zm.zones()[i];
+        const auto& e = expected.zones()[i];
+        CHECK_EQ(z.begin.offset, e.begin.offset);
+        CHECK_EQ(z.begin.line_number, e.begin.line_number);
+        CHECK_EQ(z.rows, e.rows);
+        CHECK_EQ(z.nulls, e.nulls);
+        CHECK_EQ(z.min, e.min);
+        CHECK_EQ(z.max, e.max);
+    }
+    CHECK_EQ(zm.zones()[5].nulls, 2);
+    CHECK_EQ(zm.zones()[9].rows, 5);
+
+    // the map of the rest of the file, and of a column which is missing
+    ss::parser<setup> p2{f.name, ","};
+    p2.seek(zm.zones()[9].begin);
+    auto tail = p2.build_zone_map<int>(0);
+    REQUIRE_EQ(tail.zones().size(), 1);
+    CHECK_EQ(tail.zones()[0].min, 90);
+    CHECK_EQ(tail.zones()[0].max, 94);
+
+    p2.seek(zm.zones()[9].begin);
+    auto missing = p2.build_zone_map<int>(2);
+    REQUIRE_EQ(missing.zones().size(), 1);
+    CHECK_EQ(missing.zones()[0].nulls, 5);
+    CHECK(missing.ranges(0, 100).empty());
+
+    // rows which cannot be split are counted as nulls
+    unique_file_name f_quoted;
+    {
+        std::ofstream out{f_quoted.name};
+        out << "1\n\"2\n3\n";
+    }
+    ss::parser<ss::quote<'"'>> p3{f_quoted.name, ","};
+    auto quoted = p3.build_zone_map<int>(0);
+    REQUIRE_EQ(quoted.zones().size(), 1);
+    CHECK_EQ(quoted.zones()[0].rows, 3);
+    CHECK_EQ(quoted.zones()[0].nulls, 1);
+    CHECK_EQ(quoted.zones()[0].max, 3);
+}